@@ -588,12 +588,18 @@ void birch::CppGenerator::visit(const For* o) {
 void birch::CppGenerator::visit(const Parallel* o) {
   auto index = genIndex(o->index);
   genSourceLine(o->loc);
+  line("{");
+  in();
   line("#if HAVE_NUMBIRCH_HPP");
   line("numbirch::wait();");
+  line("[[maybe_unused]] auto team_seed_ = numbirch::team_seed();");
   line("#endif");
   line("#pragma omp parallel");
   line("{");
   in();
+  line("#if HAVE_NUMBIRCH_HPP");
+  line("numbirch::seed_team(team_seed_);");
+  line("#endif");
   start("#pragma omp for schedule(");
   if (o->has(DYNAMIC)) {
     middle("guided");
@@ -612,6 +618,8 @@ void birch::CppGenerator::visit(const Parallel* o) {
   line("#endif");
   out();
   line("}");
+  out();
+  line("}");
 }
 
 void birch::CppGenerator::visit(const While* o) {
@@ -0,0 +1,521 @@
+/**
+ * @file
+ *
+ * Benchmarks of NumBirch operations. Times elementwise transformations,
+ * reductions, linear algebra and random number generation across a range of
+ * sizes, for the backend and precision against which the program is linked,
+ * and outputs the results as JSON. Optionally compares the results against
+ * those of a previous run, e.g. to detect performance regressions.
+ *
+ * Usage:
+ *
+ *     numbirch-benchmark [options]
+ *
+ * Options:
+ *
+ *     --sizes n1,n2,...         Vector sizes (default 1000,100000,1000000).
+ *     --matrix-sizes n1,n2,...  Matrix sizes (default 16,128,512).
+ *     --filter substring        Only run benchmarks with names containing
+ *                               this substring.
+ *     --min-time seconds        Minimum time per benchmark (default 0.2).
+ *     --min-repeats n           Minimum number of repeats (default 5).
+ *     --output file             Write JSON to file rather than stdout.
+ *     --compare file            Compare against a baseline JSON file
+ *                               from a previous run.
+ *     --threshold ratio         Relative slowdown beyond which a comparison
+ *                               is reported as a regression (default 0.1).
+ *
+ * When comparing, a table is written to stderr and the exit code is 1 if
+ * any benchmark regressed, 0 otherwise.
+ */
+#include "numbirch/numbirch.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace numbirch;
+
+/*
+ * Name of the precision against which the program is compiled.
+ */
+static const char* precision_name() {
+  return std::is_same_v<real,double> ? "double" : "single";
+}
+
+/*
+ * Name of the backend against which the program is compiled.
+ */
+static const char* backend_name() {
+  #if defined(BACKEND_CUDA)
+  return "cuda";
+  #elif defined(BACKEND_ONEAPI)
+  return "oneapi";
+  #else
+  return "eigen";
+  #endif
+}
+
+/*
+ * Result of a single benchmark.
+ */
+struct Result {
+  std::string name;
+  std::string precision;
+  int size;
+  int repeats;
+  double seconds;  // median time per repeat
+  double min;      // minimum time per repeat
+};
+
+/*
+ * Options.
+ */
+struct Options {
+  std::vector<int> sizes{1000, 100000, 1000000};
+  std::vector<int> matrix_sizes{16, 128, 512};
+  std::string filter;
+  double min_time = 0.2;
+  int min_repeats = 5;
+  std::string output;
+  std::string compare;
+  double threshold = 0.1;
+};
+
+/*
+ * Time a function. The function is called once to warm up, then repeatedly
+ * until both the minimum time and the minimum number of repeats are reached.
+ * Each call is followed by wait(), so that asynchronous backends are timed
+ * to completion.
+ */
+static Result run(const Options& options, const std::string& name,
+    const int size, const std::function<void()>& f) {
+  using clock = std::chrono::steady_clock;
+  f();
+  wait();
+
+  std::vector<double> times;
+  double total = 0.0;
+  while (total < options.min_time ||
+      int(times.size()) < options.min_repeats) {
+    auto start = clock::now();
+    f();
+    wait();
+    double elapsed = std::chrono::duration<double>(clock::now() - start).
+        count();
+    times.push_back(elapsed);
+    total += elapsed;
+  }
+  std::sort(times.begin(), times.end());
+
+  Result result;
+  result.name = name;
+  result.precision = precision_name();
+  result.size = size;
+  result.repeats = times.size();
+  result.seconds = times[times.size()/2];
+  result.min = times.front();
+  return result;
+}
+
+/*
+ * Vector benchmarks.
+ */
+static void vector_benchmarks(const int n,
+    std::vector<std::pair<std::string,std::function<void()>>>& benchmarks) {
+  Array<real,1> x = simulate_uniform(Array<real,1>(make_shape(n), real(0.5)),
+      real(1.5));
+  Array<real,1> y = simulate_uniform(Array<real,1>(make_shape(n), real(0.5)),
+      real(1.5));
+  Array<real,1> z = simulate_uniform(Array<real,1>(make_shape(n), real(0)),
+      real(1));
+  Array<bool,1> b = x < y;
+
+  benchmarks.push_back({"transform/exp", [=]() { exp(x); }});
+  benchmarks.push_back({"transform/log", [=]() { log(x); }});
+  benchmarks.push_back({"transform/lgamma", [=]() { lgamma(x); }});
+  benchmarks.push_back({"binary/add", [=]() { x + y; }});
+  benchmarks.push_back({"binary/hadamard", [=]() { hadamard(x, y); }});
+  benchmarks.push_back({"binary/pow", [=]() { pow(x, y); }});
+  benchmarks.push_back({"binary/lbeta", [=]() { lbeta(x, y); }});
+  benchmarks.push_back({"ternary/ibeta", [=]() { ibeta(x, y, z); }});
+  benchmarks.push_back({"ternary/where", [=]() { where(b, x, y); }});
+  benchmarks.push_back({"reduce/sum", [=]() { sum(x); }});
+  benchmarks.push_back({"reduce/count", [=]() { count(b); }});
+  benchmarks.push_back({"numeric/dot", [=]() { dot(x, y); }});
+  benchmarks.push_back({"random/standard_gaussian", [=]() {
+    standard_gaussian(n); }});
+  benchmarks.push_back({"random/simulate_gaussian", [=]() {
+    simulate_gaussian(x, y); }});
+  benchmarks.push_back({"random/simulate_gamma", [=]() {
+    simulate_gamma(x, y); }});
+  benchmarks.push_back({"random/simulate_uniform", [=]() {
+    simulate_uniform(x, real(2)); }});
+  benchmarks.push_back({"random/simulate_poisson", [=]() {
+    simulate_poisson(x); }});
+
+  /* copy-on-write of an array shared between threads, each of which writes
+   * to its own copy */
+  benchmarks.push_back({"array/copy_on_write", [=]() {
+    Array<real,1> shared(x);
+    #pragma omp parallel num_threads(get_max_threads())
+    {
+      Array<real,1> own(shared);
+      own(1) = real(0);
+    }
+  }});
+}
+
+/*
+ * Matrix benchmarks.
+ */
+static void matrix_benchmarks(const int n,
+    std::vector<std::pair<std::string,std::function<void()>>>& benchmarks) {
+  Array<real,2> A = standard_gaussian(n, n);
+  Array<real,2> B = standard_gaussian(n, n);
+  Array<real,1> x = standard_gaussian(n);
+  Array<real,1> y = standard_gaussian(n);
+  Array<real,2> S = outer(A) + diagonal(real(n), n);
+  Array<real,2> L = chol(S);
+
+  benchmarks.push_back({"numeric/chol", [=]() { chol(S); }});
+  benchmarks.push_back({"numeric/trisolve", [=]() { trisolve(L, x); }});
+  benchmarks.push_back({"numeric/trisolve_matrix", [=]() {
+    trisolve(L, B); }});
+  benchmarks.push_back({"numeric/inner", [=]() { inner(A, x); }});
+  benchmarks.push_back({"numeric/inner_matrix", [=]() { inner(A, B); }});
+  benchmarks.push_back({"numeric/outer", [=]() { outer(x, y); }});
+  benchmarks.push_back({"numeric/outer_matrix", [=]() { outer(A, B); }});
+  benchmarks.push_back({"numeric/mul", [=]() { A*x; }});
+  benchmarks.push_back({"numeric/mul_matrix", [=]() { A*B; }});
+  benchmarks.push_back({"random/standard_wishart", [=]() {
+    standard_wishart(real(n), n); }});
+}
+
+/*
+ * Escape a string for JSON.
+ */
+static std::string escape(const std::string& s) {
+  std::string result;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+/*
+ * Write results as JSON.
+ */
+static void write(std::ostream& out, const std::vector<Result>& results) {
+  char buf[64];
+  out << "{\n";
+  out << "  \"backend\": \"" << backend_name() << "\",\n";
+  out << "  \"precision\": \"" << precision_name() << "\",\n";
+  out << "  \"threads\": " << get_max_threads() << ",\n";
+  out << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    auto& r = results[i];
+    out << (i > 0 ? ",\n" : "\n");
+    out << "    {\"name\": \"" << escape(r.name) << "\", ";
+    out << "\"precision\": \"" << r.precision << "\", ";
+    out << "\"size\": " << r.size << ", ";
+    out << "\"repeats\": " << r.repeats << ", ";
+    std::snprintf(buf, sizeof(buf), "%.9g", r.seconds);
+    out << "\"seconds\": " << buf << ", ";
+    std::snprintf(buf, sizeof(buf), "%.9g", r.min);
+    out << "\"min\": " << buf << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+/*
+ * Minimal JSON reader, sufficient to read back the output of write(). Values
+ * are flattened into a list of objects (maps from key to value as a string)
+ * for the elements of the "results" array.
+ */
+class Reader {
+public:
+  Reader(const std::string& text) : text(text), pos(0) {
+    //
+  }
+
+  std::vector<std::map<std::string,std::string>> read() {
+    std::vector<std::map<std::string,std::string>> results;
+    value(results, "");
+    return results;
+  }
+
+private:
+  void value(std::vector<std::map<std::string,std::string>>& results,
+      const std::string& key) {
+    skip();
+    if (peek() == '{') {
+      object(results, key);
+    } else if (peek() == '[') {
+      ++pos;
+      skip();
+      if (peek() == ']') {
+        ++pos;
+        return;
+      }
+      do {
+        value(results, key);
+        skip();
+      } while (accept(','));
+      expect(']');
+    } else {
+      scalar();
+    }
+  }
+
+  void object(std::vector<std::map<std::string,std::string>>& results,
+      const std::string& parent) {
+    std::map<std::string,std::string> o;
+    expect('{');
+    skip();
+    if (!accept('}')) {
+      do {
+        skip();
+        auto key = string();
+        skip();
+        expect(':');
+        skip();
+        if (peek() == '{' || peek() == '[') {
+          value(results, key);
+        } else {
+          o[key] = scalar();
+        }
+        skip();
+      } while (accept(','));
+      expect('}');
+    }
+    if (parent == "results") {
+      results.push_back(o);
+    }
+  }
+
+  std::string scalar() {
+    if (peek() == '"') {
+      return string();
+    } else {
+      auto start = pos;
+      while (pos < text.size() && !std::strchr(",}] \t\r\n", text[pos])) {
+        ++pos;
+      }
+      if (pos == start) {
+        error();
+      }
+      return text.substr(start, pos - start);
+    }
+  }
+
+  std::string string() {
+    std::string s;
+    expect('"');
+    while (pos < text.size() && text[pos] != '"') {
+      if (text[pos] == '\\') {
+        ++pos;
+      }
+      if (pos < text.size()) {
+        s += text[pos++];
+      }
+    }
+    expect('"');
+    return s;
+  }
+
+  void skip() {
+    while (pos < text.size() && std::isspace(text[pos])) {
+      ++pos;
+    }
+  }
+
+  char peek() const {
+    return pos < text.size() ? text[pos] : '\0';
+  }
+
+  bool accept(const char c) {
+    if (peek() == c) {
+      ++pos;
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  void expect(const char c) {
+    if (!accept(c)) {
+      error();
+    }
+  }
+
+  [[noreturn]] void error() const {
+    std::cerr << "error: malformed JSON at offset " << pos << std::endl;
+    std::exit(2);
+  }
+
+  const std::string& text;
+  size_t pos;
+};
+
+/*
+ * Compare results against a baseline file.
+ *
+ * @return Number of regressions.
+ */
+static int compare(const std::vector<Result>& results,
+    const std::string& file, const double threshold) {
+  std::ifstream in(file);
+  if (!in) {
+    std::cerr << "error: could not open " << file << std::endl;
+    std::exit(2);
+  }
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  auto text = buffer.str();
+
+  std::map<std::string,double> baseline;
+  for (auto& o : Reader(text).read()) {
+    auto key = o["name"] + "/" + o["precision"] + "/" + o["size"];
+    baseline[key] = std::atof(o["seconds"].c_str());
+  }
+
+  int regressions = 0;
+  std::fprintf(stderr, "%-32s %-6s %8s %12s %12s %8s\n", "name", "prec",
+      "size", "baseline", "current", "ratio");
+  for (auto& r : results) {
+    auto key = r.name + "/" + r.precision + "/" + std::to_string(r.size);
+    auto iter = baseline.find(key);
+    if (iter == baseline.end()) {
+      std::fprintf(stderr, "%-32s %-6s %8d %12s %12.6g %8s\n",
+          r.name.c_str(), r.precision.c_str(), r.size, "-", r.seconds, "new");
+    } else {
+      double ratio = r.seconds/iter->second;
+      const char* status = "";
+      if (ratio > 1.0 + threshold) {
+        status = "  regression";
+        ++regressions;
+      } else if (ratio < 1.0/(1.0 + threshold)) {
+        status = "  improvement";
+      }
+      std::fprintf(stderr, "%-32s %-6s %8d %12.6g %12.6g %8.3f%s\n",
+          r.name.c_str(), r.precision.c_str(), r.size, iter->second,
+          r.seconds, ratio, status);
+    }
+  }
+  std::fprintf(stderr, "%d regression(s) beyond threshold %g\n",
+      regressions, threshold);
+  return regressions;
+}
+
+static std::vector<int> parse_sizes(const char* arg) {
+  std::vector<int> sizes;
+  std::stringstream in(arg);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    int n = std::atoi(item.c_str());
+    if (n <= 0) {
+      std::cerr << "error: invalid size " << item << std::endl;
+      std::exit(2);
+    }
+    sizes.push_back(n);
+  }
+  return sizes;
+}
+
+static Options parse_options(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg == "--help") {
+      std::cout << "usage: " << argv[0] << " [--sizes n1,n2,...] "
+          "[--matrix-sizes n1,n2,...] [--filter substring] "
+          "[--min-time seconds] [--min-repeats n] [--output file] "
+          "[--compare file] [--threshold ratio]" << std::endl;
+      std::exit(0);
+    } else if (i + 1 >= argc) {
+      std::cerr << "error: unrecognized or incomplete option " << arg <<
+          std::endl;
+      std::exit(2);
+    }
+    const char* value = argv[++i];
+    if (arg == "--sizes") {
+      options.sizes = parse_sizes(value);
+    } else if (arg == "--matrix-sizes") {
+      options.matrix_sizes = parse_sizes(value);
+    } else if (arg == "--filter") {
+      options.filter = value;
+    } else if (arg == "--min-time") {
+      options.min_time = std::atof(value);
+    } else if (arg == "--min-repeats") {
+      options.min_repeats = std::max(std::atoi(value), 1);
+    } else if (arg == "--output") {
+      options.output = value;
+    } else if (arg == "--compare") {
+      options.compare = value;
+    } else if (arg == "--threshold") {
+      options.threshold = std::atof(value);
+    } else {
+      std::cerr << "error: unrecognized option " << arg << std::endl;
+      std::exit(2);
+    }
+  }
+  return options;
+}
+
+int main(int argc, char** argv) {
+  auto options = parse_options(argc, argv);
+  init();
+  seed(1);
+
+  std::vector<Result> results;
+  auto run_all = [&](const int n, auto& benchmarks) {
+    for (auto& [name, f] : benchmarks) {
+      if (name.find(options.filter) != std::string::npos) {
+        std::cerr << name << " " << n << std::endl;
+        results.push_back(run(options, name, n, f));
+      }
+    }
+  };
+  for (auto n : options.sizes) {
+    std::vector<std::pair<std::string,std::function<void()>>> benchmarks;
+    vector_benchmarks(n, benchmarks);
+    run_all(n, benchmarks);
+  }
+  for (auto n : options.matrix_sizes) {
+    std::vector<std::pair<std::string,std::function<void()>>> benchmarks;
+    matrix_benchmarks(n, benchmarks);
+    run_all(n, benchmarks);
+  }
+
+  if (options.output.empty()) {
+    write(std::cout, results);
+  } else {
+    std::ofstream out(options.output);
+    write(out, results);
+  }
+
+  int regressions = 0;
+  if (!options.compare.empty()) {
+    regressions = compare(results, options.compare, options.threshold);
+  }
+  term();
+  return regressions > 0 ? 1 : 0;
+}
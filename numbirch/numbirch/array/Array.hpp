@@ -5,6 +5,7 @@
 
 #include "numbirch/memory.hpp"
 #include "numbirch/utility.hpp"
+#include "numbirch/instrument.hpp"
 #include "numbirch/array/ArrayShape.hpp"
 #include "numbirch/array/ArrayIterator.hpp"
 #include "numbirch/array/ArrayControl.hpp"
@@ -178,11 +179,17 @@ public:
 
   /**
    * View constructor.
+   *
+   * @param ctl Control block.
+   * @param shp Shape.
+   * @param isView Is this a view? If false, the array takes ownership of
+   * the reference held by the caller on @p ctl, as for a control block
+   * newly constructed over a memory-mapped file.
    */
-  Array(ArrayControl* ctl, const shape_type& shp) :
-      ctl(ctl),
+  Array(ArrayControl* ctl, const shape_type& shp, const bool isView = true) :
+      ctl(reinterpret_cast<uintptr_t>(ctl)),
       shp(shp),
-      isView(true) {
+      isView(isView) {
     //
   }
 
@@ -202,12 +209,12 @@ public:
       allocate();
       copy(o);
     } else if (volume() > 0) {
-      auto c = o.control();
-      assert(c);
+      auto c = o.borrow();
       c->incShared();
-      ctl.store(c);
+      o.unborrow(c);
+      ctl.store(reinterpret_cast<uintptr_t>(c));
     } else {
-      ctl.store(nullptr);
+      ctl.store(0);
     }
   }
 
@@ -229,7 +236,7 @@ public:
       shp(o.shp),
       isView(false) {
     if (!o.isView) {
-      ctl.store(nullptr);
+      ctl.store(0);
       swap(o);
     } else {
       allocate();
@@ -242,7 +249,7 @@ public:
    */
   ~Array() {
     if (!isView && volume() > 0) {
-      ArrayControl* c = ctl.load();
+      ArrayControl* c = untag(ctl.load());
       if (c && c->decShared() == 0) {
         delete c;
       }
@@ -612,27 +619,26 @@ public:
     if (volume() == 0) {
       /* allocate new */
       d = new ArrayControl(newsize);
+      ctl.store(reinterpret_cast<uintptr_t>(d));
     } else {
-      /* use ctl as a lock: exchange with nullptr, copy on write if necessary,
-       * resize buffer */
-      ArrayControl* c;
-      do {
-        c = ctl.exchange(nullptr);
-      } while (!c);
-      if (c->numShared() > 1) {
-        /* copy-on-write and resize simultaneously */
-        d = new ArrayControl(*c, newsize);
-        if (c->decShared() == 0) {
-          delete c;
+      /* copy-on-write and resize simultaneously if necessary, otherwise
+       * resize in place */
+      while (!d) {
+        ArrayControl* c = borrow();
+        if (c->numShared() > 1 || c->isReadOnly()) {
+          ArrayControl* e = new ArrayControl(*c, newsize);
+          if (replace(c, e)) {
+            d = e;
+          }
+        } else {
+          unborrow(c);
+          d = c;
+          d->realloc(newsize);
         }
-      } else {
-        d = c;
-        d->realloc(newsize);
       }
     }
     memset(Sliced<T>(d, volume(), true).data(), stride(), value, 1, 1);
     shp.extend(1);
-    ctl.store(d);  // also unlocks
   }
 
   /**
@@ -687,24 +693,22 @@ public:
   ArrayControl* control() {
     if (volume() > 0) {
       if (isView) {
-        return ctl.load();
+        return untag(ctl.load());
       } else {
-        /* ctl is used as a lock, it may be set to nullptr while another
-         * thread is working on a copy-on-write */
-        ArrayControl* c;
-        do {
-          c = ctl.exchange(nullptr);
-        } while (!c);
-        if (c->numShared() > 1) {
-          /* copy for write */
-          ArrayControl* d = new ArrayControl(*c);
-          if (c->decShared() == 0) {
-            delete c;
+        /* copy-on-write if necessary; if another thread does so first, use
+         * its copy instead */
+        while (true) {
+          ArrayControl* c = borrow();
+          if (c->numShared() > 1 || c->isReadOnly()) {
+            ArrayControl* d = new ArrayControl(*c);
+            if (replace(c, d)) {
+              return d;
+            }
+          } else {
+            unborrow(c);
+            return c;
           }
-          c = d;
         }
-        ctl.store(c);
-        return c;
       }
     } else {
       return nullptr;
@@ -718,17 +722,7 @@ public:
    */
   ArrayControl* control() const {
     if (volume() > 0) {
-      if (isView) {
-        return ctl.load();
-      } else {
-        /* ctl is used as a lock, it may be set to nullptr while another thread
-         * is working on a copy-on-write */
-        ArrayControl* c;
-        do {
-          c = const_cast<Array*>(this)->ctl.load();
-        } while (!c);
-        return c;
-      }
+      return untag(ctl.load());
     } else {
       return nullptr;
     }
@@ -779,8 +773,8 @@ private:
   void swap(Array& o) {
     assert(!isView);
     assert(!o.isView);
-    auto c = volume() > 0 ? ctl.exchange(nullptr) : nullptr;
-    auto d = o.volume() > 0 ? o.ctl.exchange(nullptr) : nullptr;
+    uintptr_t c = volume() > 0 ? ctl.exchange(0) : 0;
+    uintptr_t d = o.volume() > 0 ? o.ctl.exchange(0) : 0;
     std::swap(shp, o.shp);
     if (d) {
       ctl.store(d);
@@ -799,13 +793,96 @@ private:
     if (volume() > 0) {
       c = new ArrayControl(shp.volume()*sizeof(T));
     }
-    ctl.store(c);
+    ctl.store(reinterpret_cast<uintptr_t>(c));
+  }
+
+  /**
+   * Control block of a control word, without the borrow count.
+   */
+  static ArrayControl* untag(const uintptr_t word) {
+    return reinterpret_cast<ArrayControl*>(word & ~array_borrow_mask);
+  }
+
+  /**
+   * Borrow the control block. While borrowed, it is not destroyed, even if
+   * another thread replaces it.
+   *
+   * @return Control block, to be returned with unborrow() or replace().
+   *
+   * The number of threads that have borrowed the control block is kept in
+   * the low bits of the control word, which is updated by compare-and-swap
+   * rather than used as a lock. A thread waits only if the count is
+   * saturated, or retries if another thread updates the word first; both
+   * are counted as contention.
+   */
+  ArrayControl* borrow() const {
+    auto& word = const_cast<Array*>(this)->ctl;
+    uintptr_t w = word.load();
+    while ((w & array_borrow_mask) == array_borrow_mask ||
+        !word.compare_exchange(w, w + 1)) {
+      if ((w & array_borrow_mask) == array_borrow_mask) {
+        w = word.load();
+      }
+      instrument_contention();
+    }
+    return untag(w);
+  }
+
+  /**
+   * Return a borrowed control block.
+   *
+   * @param c Control block.
+   */
+  void unborrow(ArrayControl* c) const {
+    auto& word = const_cast<Array*>(this)->ctl;
+    uintptr_t w = word.load();
+    while (untag(w) == c) {
+      if (word.compare_exchange(w, w - 1)) {
+        return;
+      }
+      instrument_contention();
+    }
+
+    /* another thread has replaced the control block, and transferred the
+     * borrow into its reference count */
+    if (c->decShared() == 0) {
+      delete c;
+    }
+  }
+
+  /**
+   * Replace a borrowed control block.
+   *
+   * @param c Borrowed control block.
+   * @param d New control block.
+   *
+   * @return True if successful. False if another thread has already replaced
+   * @p c, in which case @p d is destroyed and @p c returned.
+   */
+  bool replace(ArrayControl* c, ArrayControl* d) {
+    uintptr_t w = ctl.load();
+    while (untag(w) == c) {
+      if (ctl.compare_exchange(w, reinterpret_cast<uintptr_t>(d))) {
+        /* transfer the borrows of other threads into the reference count,
+         * then release the borrow of this thread and the reference of this
+         * array */
+        int n = int(w & array_borrow_mask);
+        if (c->addShared(n - 2) == 0) {
+          delete c;
+        }
+        return true;
+      }
+      instrument_contention();
+    }
+    delete d;
+    unborrow(c);
+    return false;
   }
 
   /**
    * Buffer control block.
    */
-  Atomic<ArrayControl*> ctl;
+  Atomic<uintptr_t> ctl;
 
   /**
    * Shape.
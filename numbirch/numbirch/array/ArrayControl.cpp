@@ -4,30 +4,60 @@
 #include "numbirch/array/ArrayControl.hpp"
 
 #include "numbirch/memory.hpp"
+#include "numbirch/instrument.hpp"
 
 #include <algorithm>
 
+#include <sys/mman.h>
+
 namespace numbirch {
 
 ArrayControl::ArrayControl(const size_t size) :
+    map(nullptr),
+    mapSize(0),
     r(1) {
   array_init(this, size);
+  instrument_alloc(size);
 }
 
 ArrayControl::ArrayControl(const ArrayControl& o) :
+    map(nullptr),
+    mapSize(0),
     r(1) {
   array_init(this, o.size);
   array_copy(this, &o);
+  instrument_alloc(o.size);
+  instrument_copy(o.size);
 }
 
 ArrayControl::ArrayControl(const ArrayControl& o, const size_t size) :
+    map(nullptr),
+    mapSize(0),
     r(1) {
   array_init(this, size);
   array_copy(this, &o);
+  instrument_alloc(size);
+  instrument_copy(std::min(size, o.size));
+}
+
+ArrayControl::ArrayControl(void* map, const size_t mapSize,
+    const size_t offset, const size_t size) :
+    buf(static_cast<char*>(map) + offset),
+    size(size),
+    map(map),
+    mapSize(mapSize),
+    r(1) {
+  array_map(this);
 }
 
 ArrayControl::~ArrayControl() {
-  array_term(this);
+  if (map) {
+    array_unmap(this);
+    ::munmap(map, mapSize);
+  } else {
+    instrument_free(size);
+    array_term(this);
+  }
 }
 
 bool ArrayControl::test() {
@@ -35,7 +65,10 @@ bool ArrayControl::test() {
 }
 
 void ArrayControl::realloc(const size_t size) {
+  assert(!isReadOnly());
+  instrument_free(this->size);
   array_resize(this, size);
+  instrument_alloc(size);
 }
 
 }
@@ -8,6 +8,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstddef>
+#include <string>
 
 namespace numbirch {
 /**
@@ -15,10 +16,14 @@ namespace numbirch {
  * 
  * Control block for buffers, handling reference counting and event
  * management.
+ *
+ * The control block is aligned to a cache line, so that reference counting
+ * on one does not contend with that on another, and so that Array can use
+ * the low bits of a pointer to it as a counter.
  * 
  * @ingroup array
  */
-class ArrayControl {
+class alignas(64) ArrayControl {
 public:
   /**
    * Constructor.
@@ -54,6 +59,24 @@ public:
    */
   ArrayControl(const ArrayControl& o, const size_t size);
 
+  /**
+   * Constructor for a read-only buffer backed by a memory-mapped file.
+   *
+   * @param map Start of the mapping, as returned by `mmap()`.
+   * @param mapSize Size of the mapping, in bytes.
+   * @param offset Offset of the buffer in the mapping, in bytes.
+   * @param size Buffer size, in bytes.
+   *
+   * The object is initialized with a reference count of one. The caller
+   * need not (should not) call incShared(). The object takes ownership of
+   * the mapping, and unmaps it on destruction. The file should be mapped
+   * read-only and shared between all processes that map it, so that its
+   * pages are loaded on demand and not copied. Array copies the buffer
+   * before any write, as for copy-on-write.
+   */
+  ArrayControl(void* map, const size_t mapSize, const size_t offset,
+      const size_t size);
+
   /**
    * Destructor.
    */
@@ -82,6 +105,23 @@ public:
     return --r;
   }
 
+  /**
+   * Add to the shared reference count and return the new value.
+   *
+   * @param n Number to add, which may be negative.
+   */
+  int addShared(const int n) {
+    return r += n;
+  }
+
+  /**
+   * Is the buffer read-only? This is the case for a buffer backed by a
+   * memory-mapped file.
+   */
+  bool isReadOnly() const {
+    return map != nullptr;
+  }
+
   /**
    * Have all outstanding reads and writes on the buffer finished?
    */
@@ -114,10 +154,32 @@ public:
    */
   size_t size;
 
+  /**
+   * Start of the memory-mapped file, if the buffer is backed by one,
+   * otherwise `nullptr`.
+   */
+  void* map;
+
+  /**
+   * Size of the memory-mapped file, in bytes.
+   */
+  size_t mapSize;
+
   /**
    * Reference count.
    */
   Atomic<int> r;
 };
 
+/**
+ * @internal
+ *
+ * Mask of the low bits of a pointer to ArrayControl, which are zero by
+ * alignment. Array uses them to count the threads that have borrowed the
+ * control block.
+ *
+ * @ingroup array
+ */
+inline constexpr uintptr_t array_borrow_mask = alignof(ArrayControl) - 1;
+
 }
@@ -16,8 +16,8 @@
  * consistency and the organic disabling of atomics when OpenMP, and thus
  * multithreading, is disabled (this can improve performance significantly for
  * single threading). The disadvantage is that OpenMP atomics do not support
- * compare-and-swap/compare-and-exchange, only swap/exchange, which can
- * require some clunkier client code, especially for read-write locks.
+ * compare-and-swap/compare-and-exchange, only swap/exchange, so that
+ * Atomic::compare_exchange() falls back to compiler intrinsics.
  */
 #define NUMBIRCH_ATOMIC_OPENMP 1
 
@@ -105,6 +105,29 @@ public:
     #endif
   }
 
+  /**
+   * Compare the value with an expected value and, if equal, replace it with
+   * a desired value, atomically.
+   *
+   * @param[in,out] expected Expected value. On failure, this is updated to
+   * the current value.
+   * @param desired Desired value.
+   *
+   * @return True on success, false on failure.
+   *
+   * The OpenMP implementation uses compiler intrinsics, which remain atomic
+   * even when OpenMP is disabled.
+   */
+  bool compare_exchange(T& expected, const T& desired) {
+    #if NUMBIRCH_ATOMIC_OPENMP
+    return __atomic_compare_exchange_n(&this->value, &expected, desired,
+        false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    #else
+    return this->value.compare_exchange_strong(expected, desired,
+        std::memory_order_acq_rel, std::memory_order_acquire);
+    #endif
+  }
+
   /**
    * Increment the value by one, atomically, but without capturing the
    * current value.
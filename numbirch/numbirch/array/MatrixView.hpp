@@ -0,0 +1,222 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "numbirch/array/Array.hpp"
+
+namespace numbirch {
+/**
+ * Transposed view of a matrix.
+ *
+ * @ingroup array
+ *
+ * @tparam T Value type.
+ *
+ * The view shares the buffer of the matrix, by copy-on-write, and so does
+ * not copy its elements. Linear algebra functions that accept a view apply
+ * the transpose as part of the operation, rather than materializing it.
+ *
+ * @see transpose_view()
+ */
+template<class T>
+class TransposeView {
+public:
+  /**
+   * Constructor.
+   *
+   * @param A Matrix $A$, of which the view is $A^\top$.
+   */
+  explicit TransposeView(const Array<T,2>& A) :
+      A(A) {
+    //
+  }
+
+  /**
+   * Underlying matrix $A$, of which the view is $A^\top$.
+   */
+  const Array<T,2>& base() const {
+    return A;
+  }
+
+  /**
+   * Number of rows of the view.
+   */
+  int rows() const {
+    return A.columns();
+  }
+
+  /**
+   * Number of columns of the view.
+   */
+  int columns() const {
+    return A.rows();
+  }
+
+private:
+  /**
+   * Underlying matrix.
+   */
+  Array<T,2> A;
+};
+
+/**
+ * Lower-triangular view of a matrix, with its diagonal scaled.
+ *
+ * @ingroup array
+ *
+ * @tparam T Value type.
+ *
+ * The view is of the lower triangle of a matrix $A$, with the strict upper
+ * triangle taken as zero and the diagonal multiplied by a factor $d$. It
+ * shares the buffer of $A$, by copy-on-write, and so does not copy its
+ * elements. With $d = 1$ it is equivalent to tri(), and with $d = 1/2$ to
+ * phi().
+ *
+ * @see tri_view(), phi_view()
+ */
+template<class T>
+class TriView {
+public:
+  /**
+   * Constructor.
+   *
+   * @param A Matrix $A$.
+   * @param d Factor for the diagonal.
+   */
+  TriView(const Array<T,2>& A, const T d) :
+      A(A),
+      d(d) {
+    //
+  }
+
+  /**
+   * Underlying matrix $A$.
+   */
+  const Array<T,2>& base() const {
+    return A;
+  }
+
+  /**
+   * Factor for the diagonal.
+   */
+  T diagonal() const {
+    return d;
+  }
+
+  /**
+   * Number of rows of the view.
+   */
+  int rows() const {
+    return A.rows();
+  }
+
+  /**
+   * Number of columns of the view.
+   */
+  int columns() const {
+    return A.columns();
+  }
+
+private:
+  /**
+   * Underlying matrix.
+   */
+  Array<T,2> A;
+
+  /**
+   * Factor for the diagonal.
+   */
+  T d;
+};
+
+/**
+ * Transposed view of a matrix.
+ *
+ * @ingroup array
+ *
+ * @param A Matrix $A$.
+ *
+ * @return View of $A^\top$.
+ *
+ * @see transpose()
+ */
+template<class T>
+TransposeView<T> transpose_view(const Array<T,2>& A) {
+  return TransposeView<T>(A);
+}
+
+/**
+ * Lower-triangular view of a matrix.
+ *
+ * @ingroup array
+ *
+ * @param A Matrix $A$.
+ *
+ * @return View of the lower triangle of $A$.
+ *
+ * @see tri()
+ */
+template<class T>
+TriView<T> tri_view(const Array<T,2>& A) {
+  return TriView<T>(A, T(1));
+}
+
+/**
+ * Lower-triangular view of a matrix, with its diagonal halved.
+ *
+ * @ingroup array
+ *
+ * @param A Matrix $A$.
+ *
+ * @return View of the lower triangle of $A$, with its diagonal multiplied
+ * by one half.
+ *
+ * @see phi()
+ */
+template<class T>
+TriView<T> phi_view(const Array<T,2>& A) {
+  return TriView<T>(A, T(0.5));
+}
+
+/**
+ * Number of rows of a view.
+ *
+ * @ingroup array
+ */
+template<class T>
+int rows(const TransposeView<T>& A) {
+  return A.rows();
+}
+
+/**
+ * Number of columns of a view.
+ *
+ * @ingroup array
+ */
+template<class T>
+int columns(const TransposeView<T>& A) {
+  return A.columns();
+}
+
+/**
+ * Number of rows of a view.
+ *
+ * @ingroup array
+ */
+template<class T>
+int rows(const TriView<T>& L) {
+  return L.rows();
+}
+
+/**
+ * Number of columns of a view.
+ *
+ * @ingroup array
+ */
+template<class T>
+int columns(const TriView<T>& L) {
+  return L.columns();
+}
+
+}
@@ -0,0 +1,240 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "numbirch/array/Array.hpp"
+
+namespace numbirch {
+/**
+ * Sparse matrix, in compressed sparse column (CSC) format.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Value type.
+ *
+ * The nonzero elements of column $j$ are at positions `outer[j]` to
+ * `outer[j + 1] - 1` (zero-based) of `inner`, which gives their row indices
+ * (zero-based, ascending), and of `values`, which gives their values. The
+ * three arrays are shared by copy-on-write, so that copying a sparse matrix
+ * does not copy its elements.
+ *
+ * @see sparse(), dense()
+ */
+template<class T>
+class SparseMatrix {
+public:
+  /**
+   * Constructor. Constructs an empty matrix.
+   */
+  SparseMatrix() :
+      outer(make_shape(1), 0),
+      m(0),
+      n(0) {
+    //
+  }
+
+  /**
+   * Constructor.
+   *
+   * @param m Number of rows.
+   * @param n Number of columns.
+   * @param outer Column offsets, of length $n + 1$.
+   * @param inner Row indices of nonzero elements.
+   * @param values Values of nonzero elements.
+   */
+  SparseMatrix(const int m, const int n, const Array<int,1>& outer,
+      const Array<int,1>& inner, const Array<T,1>& values) :
+      outer(outer),
+      inner(inner),
+      values(values),
+      m(m),
+      n(n) {
+    assert(outer.length() == n + 1);
+    assert(inner.length() == values.length());
+  }
+
+  /**
+   * Number of rows.
+   */
+  int rows() const {
+    return m;
+  }
+
+  /**
+   * Number of columns.
+   */
+  int columns() const {
+    return n;
+  }
+
+  /**
+   * Number of nonzero elements.
+   */
+  int nonzeros() const {
+    return values.length();
+  }
+
+  /**
+   * Column offsets.
+   */
+  const Array<int,1>& offsets() const {
+    return outer;
+  }
+
+  /**
+   * Row indices of nonzero elements.
+   */
+  const Array<int,1>& indices() const {
+    return inner;
+  }
+
+  /**
+   * Values of nonzero elements.
+   */
+  const Array<T,1>& data() const {
+    return values;
+  }
+
+private:
+  /**
+   * Column offsets.
+   */
+  Array<int,1> outer;
+
+  /**
+   * Row indices of nonzero elements.
+   */
+  Array<int,1> inner;
+
+  /**
+   * Values of nonzero elements.
+   */
+  Array<T,1> values;
+
+  /**
+   * Number of rows.
+   */
+  int m;
+
+  /**
+   * Number of columns.
+   */
+  int n;
+};
+
+/**
+ * Cholesky factorization of a sparse symmetric positive definite matrix.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Value type.
+ *
+ * For a matrix $S$, holds the lower-triangular sparse matrix $L$ and
+ * permutation $P$ such that $PSP^\top = LL^\top$. The permutation reduces
+ * the number of nonzero elements of $L$.
+ *
+ * @see chol()
+ */
+template<class T>
+class SparseCholesky {
+public:
+  /**
+   * Constructor. Constructs an empty factorization.
+   */
+  SparseCholesky() = default;
+
+  /**
+   * Constructor.
+   *
+   * @param L Lower-triangular factor.
+   * @param perm Permutation, where element $i$ is the (zero-based) index
+   * to which row $i$ of $S$ is moved.
+   */
+  SparseCholesky(const SparseMatrix<T>& L, const Array<int,1>& perm) :
+      L(L),
+      perm(perm) {
+    assert(L.rows() == perm.length());
+  }
+
+  /**
+   * Lower-triangular factor.
+   */
+  const SparseMatrix<T>& factor() const {
+    return L;
+  }
+
+  /**
+   * Permutation.
+   */
+  const Array<int,1>& permutation() const {
+    return perm;
+  }
+
+  /**
+   * Number of rows.
+   */
+  int rows() const {
+    return L.rows();
+  }
+
+  /**
+   * Number of columns.
+   */
+  int columns() const {
+    return L.columns();
+  }
+
+private:
+  /**
+   * Lower-triangular factor.
+   */
+  SparseMatrix<T> L;
+
+  /**
+   * Permutation.
+   */
+  Array<int,1> perm;
+};
+
+/**
+ * Number of rows of a sparse matrix.
+ *
+ * @ingroup sparse
+ */
+template<class T>
+int rows(const SparseMatrix<T>& S) {
+  return S.rows();
+}
+
+/**
+ * Number of columns of a sparse matrix.
+ *
+ * @ingroup sparse
+ */
+template<class T>
+int columns(const SparseMatrix<T>& S) {
+  return S.columns();
+}
+
+/**
+ * Number of rows of a sparse Cholesky factorization.
+ *
+ * @ingroup sparse
+ */
+template<class T>
+int rows(const SparseCholesky<T>& C) {
+  return C.rows();
+}
+
+/**
+ * Number of columns of a sparse Cholesky factorization.
+ *
+ * @ingroup sparse
+ */
+template<class T>
+int columns(const SparseCholesky<T>& C) {
+  return C.columns();
+}
+
+}
@@ -0,0 +1,251 @@
+/**
+ * @file
+ */
+#include "numbirch/instrument.hpp"
+#include "numbirch/thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdlib>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace numbirch {
+/*
+ * Counters for a single function, on a single thread.
+ */
+struct InstrumentEntry {
+  int64_t calls = 0;
+  int64_t bytes = 0;
+  int64_t nanoseconds = 0;
+};
+
+/*
+ * Counters for all functions called on a single thread. Each thread updates
+ * its own table, so that the lock is uncontended except while taking a
+ * snapshot or resetting. Entries are never erased, so that pointers to them
+ * remain valid.
+ */
+struct InstrumentTable {
+  std::mutex mutex;
+  std::unordered_map<const char*,InstrumentEntry> entries;
+  InstrumentEntry* current = nullptr;
+};
+
+static std::atomic<bool> instrument_on(false);
+static std::atomic<bool> instrument_numa_on(false);
+static std::atomic<int64_t> instrument_allocations(0);
+static std::atomic<int64_t> instrument_bytes(0);
+static std::atomic<int64_t> instrument_live(0);
+static std::atomic<int64_t> instrument_peak(0);
+static std::atomic<int64_t> instrument_copies(0);
+static std::atomic<int64_t> instrument_copied(0);
+static std::atomic<int64_t> instrument_contentions(0);
+static std::atomic<int64_t> instrument_local(0);
+static std::atomic<int64_t> instrument_remote(0);
+
+static std::mutex instrument_tables_mutex;
+static std::vector<std::unique_ptr<InstrumentTable>> instrument_tables;
+
+/*
+ * Table for the calling thread, created on first use.
+ */
+static InstrumentTable* instrument_table() {
+  static thread_local InstrumentTable* table = nullptr;
+  if (!table) {
+    std::lock_guard<std::mutex> lock(instrument_tables_mutex);
+    instrument_tables.push_back(std::make_unique<InstrumentTable>());
+    table = instrument_tables.back().get();
+  }
+  return table;
+}
+
+static int64_t instrument_now() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).
+      count();
+}
+
+const char* instrument_name(const char* name) {
+  std::string result(name);
+#if defined(__GNUG__)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && demangled) {
+    result = demangled;
+  }
+  std::free(demangled);
+#endif
+  for (std::string s : {"numbirch::", "_functor"}) {
+    for (auto pos = result.find(s); pos != std::string::npos;
+        pos = result.find(s, pos)) {
+      result.erase(pos, s.length());
+    }
+  }
+
+  /* intern, so that the name has static storage duration */
+  static std::mutex mutex;
+  static std::set<std::string> names;
+  std::lock_guard<std::mutex> lock(mutex);
+  return names.insert(result).first->c_str();
+}
+
+void set_instrument(const bool on) {
+  instrument_on.store(on, std::memory_order_relaxed);
+}
+
+bool get_instrument() {
+  return instrument_on.load(std::memory_order_relaxed);
+}
+
+void set_instrument_numa(const bool on) {
+  instrument_numa_on.store(on, std::memory_order_relaxed);
+}
+
+bool get_instrument_numa() {
+  return instrument_numa_on.load(std::memory_order_relaxed);
+}
+
+InstrumentSnapshot instrument_snapshot() {
+  /* merge entries with the same name, from different threads or from
+   * different instantiations of the same function template */
+  std::map<std::string,InstrumentEntry> merged;
+  {
+    std::lock_guard<std::mutex> lock(instrument_tables_mutex);
+    for (auto& table : instrument_tables) {
+      std::lock_guard<std::mutex> lock(table->mutex);
+      for (auto& [name, entry] : table->entries) {
+        if (entry.calls > 0) {
+          auto& to = merged[name];
+          to.calls += entry.calls;
+          to.bytes += entry.bytes;
+          to.nanoseconds += entry.nanoseconds;
+        }
+      }
+    }
+  }
+
+  InstrumentSnapshot snapshot;
+  snapshot.functions.reserve(merged.size());
+  for (auto& [name, entry] : merged) {
+    snapshot.functions.push_back({name, entry.calls, entry.bytes,
+        1.0e-9*entry.nanoseconds});
+  }
+  snapshot.allocations = instrument_allocations.load();
+  snapshot.bytes = instrument_bytes.load();
+  snapshot.live = instrument_live.load();
+  snapshot.peak = instrument_peak.load();
+  snapshot.copies = instrument_copies.load();
+  snapshot.copied = instrument_copied.load();
+  snapshot.contentions = instrument_contentions.load();
+  snapshot.local = instrument_local.load();
+  snapshot.remote = instrument_remote.load();
+  return snapshot;
+}
+
+void instrument_reset() {
+  {
+    std::lock_guard<std::mutex> lock(instrument_tables_mutex);
+    for (auto& table : instrument_tables) {
+      std::lock_guard<std::mutex> lock(table->mutex);
+      for (auto& [name, entry] : table->entries) {
+        entry = InstrumentEntry();
+      }
+    }
+  }
+  instrument_allocations.store(0);
+  instrument_bytes.store(0);
+  instrument_peak.store(instrument_live.load());
+  instrument_copies.store(0);
+  instrument_copied.store(0);
+  instrument_contentions.store(0);
+  instrument_local.store(0);
+  instrument_remote.store(0);
+}
+
+void instrument_alloc(const size_t size) {
+  if (get_instrument()) {
+    instrument_allocations.fetch_add(1, std::memory_order_relaxed);
+    instrument_bytes.fetch_add(size, std::memory_order_relaxed);
+    auto live = instrument_live.fetch_add(size, std::memory_order_relaxed) +
+        int64_t(size);
+    auto peak = instrument_peak.load(std::memory_order_relaxed);
+    while (live > peak && !instrument_peak.compare_exchange_weak(peak, live,
+        std::memory_order_relaxed)) {
+      //
+    }
+    auto table = instrument_table();
+    if (table->current) {
+      std::lock_guard<std::mutex> lock(table->mutex);
+      table->current->bytes += size;
+    }
+  }
+}
+
+void instrument_free(const size_t size) {
+  if (get_instrument()) {
+    instrument_live.fetch_sub(size, std::memory_order_relaxed);
+  }
+}
+
+void instrument_copy(const size_t size) {
+  if (get_instrument()) {
+    instrument_copies.fetch_add(1, std::memory_order_relaxed);
+    instrument_copied.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+
+void instrument_contention() {
+  if (get_instrument()) {
+    instrument_contentions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void instrument_access(const void* ptr) {
+  if (ptr && get_instrument() && get_instrument_numa()) {
+    auto node = get_numa_node(ptr);
+    if (node >= 0) {
+      if (node == get_numa_node()) {
+        instrument_local.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        instrument_remote.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+Instrument::Instrument(const char* name) :
+    record(nullptr),
+    caller(nullptr),
+    start(0) {
+  if (get_instrument()) {
+    auto table = instrument_table();
+    std::lock_guard<std::mutex> lock(table->mutex);
+    auto entry = &table->entries[name];
+    caller = table->current;
+    table->current = entry;
+    record = entry;
+    start = instrument_now();
+  }
+}
+
+Instrument::~Instrument() {
+  if (record) {
+    auto elapsed = instrument_now() - start;
+    auto table = instrument_table();
+    std::lock_guard<std::mutex> lock(table->mutex);
+    auto entry = static_cast<InstrumentEntry*>(record);
+    ++entry->calls;
+    entry->nanoseconds += elapsed;
+    table->current = static_cast<InstrumentEntry*>(caller);
+  }
+}
+
+}
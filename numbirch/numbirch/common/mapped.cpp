@@ -0,0 +1,81 @@
+/**
+ * @file
+ */
+#include "numbirch/mapped.hpp"
+
+#include <fstream>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace numbirch {
+static const char mapped_magic[8] = {'N', 'B', 'A', 'R', 'R', 'A', 'Y', '\0'};
+
+bool map_file(const std::string& path, const int32_t type,
+    const int32_t ndims, int& rows, int& columns, ArrayControl*& ctl) {
+  MappedHeader header;
+  std::ifstream in(path, std::ios::binary);
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  in.close();
+  if (std::memcmp(header.magic, mapped_magic, sizeof(mapped_magic)) != 0 ||
+      header.type != type || header.ndims != ndims) {
+    return false;
+  }
+  rows = header.rows;
+  columns = header.columns;
+  ctl = nullptr;
+
+  size_t size = size_t(header.rows)*size_t(header.columns);
+  switch (type) {
+    case mapped_type<double>(): size *= sizeof(double); break;
+    case mapped_type<float>(): size *= sizeof(float); break;
+    case mapped_type<int>(): size *= sizeof(int); break;
+    default: size *= sizeof(bool); break;
+  }
+  if (size > 0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(header) + size) {
+      ::close(fd);
+      return false;
+    }
+    size_t mapSize = st.st_size;
+    void* map = ::mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // mapping remains valid
+    if (map == MAP_FAILED) {
+      return false;
+    }
+    ctl = new ArrayControl(map, mapSize, sizeof(header), size);
+  }
+  return true;
+}
+
+bool write_file(const std::string& path, const int32_t type,
+    const int32_t ndims, const int rows, const int columns,
+    const void* data, const size_t size) {
+  MappedHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, mapped_magic, sizeof(mapped_magic));
+  header.type = type;
+  header.ndims = ndims;
+  header.rows = rows;
+  header.columns = columns;
+
+  std::ofstream out(path, std::ios::binary|std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (size > 0) {
+    out.write(static_cast<const char*>(data), size);
+  }
+  out.close();
+  return bool(out);
+}
+
+}
@@ -3,7 +3,39 @@
  */
 #include "numbirch/common/random.hpp"
 
+#include <limits>
+
+#if HAVE_OMP_H
+#include <omp.h>
+#endif
+
 namespace numbirch {
 thread_local std::mt19937 rng32;
 thread_local std::mt19937_64 rng64;
+
+int team_seed() {
+#if HAVE_OMP_H
+  if (omp_get_level() > 0) {
+    return std::uniform_int_distribution<int>(0,
+        std::numeric_limits<int>::max())(rng64);
+  }
+#endif
+  return -1;
+}
+
+void seed_thread(const int s, const int n) {
+  std::seed_seq seq{s, n};
+  rng32.seed(seq);
+  rng64.seed(seq);
+}
+
+void seed_team(const int s) {
+#if HAVE_OMP_H
+  auto n = omp_get_thread_num();
+  if (s >= 0 && n > 0) {
+    seed_thread(s, n);
+  }
+#endif
+}
+
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "numbirch/reduce.hpp"
+#include "numbirch/instrument.hpp"
 #include "numbirch/array.hpp"
 
 namespace numbirch {
@@ -44,6 +45,7 @@ struct sum_grad_functor {
 template<class R, class T, class>
 real_t<T> count_grad(const Array<real,0>& g, const Array<R,0>& y,
     const T& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   prefetch(x);
   return transform(x, count_grad_functor());
 }
@@ -51,6 +53,7 @@ real_t<T> count_grad(const Array<real,0>& g, const Array<R,0>& y,
 template<class R, class T, class>
 real_t<T> sum_grad(const Array<real,0>& g, const Array<R,0>& y,
     const T& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   prefetch(x);
   return transform(x, sum_grad_functor(sliced(g)));
 }
@@ -0,0 +1,341 @@
+/**
+ * @file
+ *
+ * Sparse matrix functions. These are implemented on host with Eigen's
+ * sparse module for all backends; with unified memory, the arrays are
+ * accessible on host for the CUDA backend too.
+ */
+#pragma once
+
+#include "numbirch/sparse.hpp"
+#include "numbirch/instrument.hpp"
+#include "numbirch/array.hpp"
+#include "numbirch/reduce.hpp"
+#include "numbirch/transform.hpp"
+
+#if defined(HAVE_EIGEN_DENSE)
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#elif defined(HAVE_EIGEN3_EIGEN_DENSE)
+#include <eigen3/Eigen/Dense>
+#include <eigen3/Eigen/Sparse>
+#include <eigen3/Eigen/SparseCholesky>
+#endif
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace numbirch {
+template<class T>
+using EigenSparse = Eigen::SparseMatrix<T,Eigen::ColMajor,int>;
+
+/*
+ * Eigen map of a sparse matrix, on host.
+ */
+template<class T>
+static auto sparse_eigen(const SparseMatrix<T>& S) {
+  return Eigen::Map<const EigenSparse<T>>(S.rows(), S.columns(),
+      S.nonzeros(), S.offsets().diced(), S.indices().diced(),
+      S.data().diced());
+}
+
+/*
+ * Eigen map of a dense vector, on host.
+ */
+template<class T>
+static auto host_eigen(const Array<T,1>& x) {
+  using Stride = Eigen::InnerStride<Eigen::Dynamic>;
+  return Eigen::Map<const Eigen::Matrix<T,Eigen::Dynamic,1>,Eigen::DontAlign,
+      Stride>(x.diced(), length(x), Stride(stride(x)));
+}
+
+template<class T>
+static auto host_eigen(Array<T,1>& x) {
+  using Stride = Eigen::InnerStride<Eigen::Dynamic>;
+  return Eigen::Map<Eigen::Matrix<T,Eigen::Dynamic,1>,Eigen::DontAlign,
+      Stride>(x.diced(), length(x), Stride(stride(x)));
+}
+
+/*
+ * Eigen map of a dense matrix, on host.
+ */
+template<class T>
+static auto host_eigen(const Array<T,2>& A) {
+  using Stride = Eigen::OuterStride<Eigen::Dynamic>;
+  return Eigen::Map<const Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>,
+      Eigen::DontAlign,Stride>(A.diced(), rows(A), columns(A),
+      Stride(stride(A)));
+}
+
+template<class T>
+static auto host_eigen(Array<T,2>& A) {
+  using Stride = Eigen::OuterStride<Eigen::Dynamic>;
+  return Eigen::Map<Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>,
+      Eigen::DontAlign,Stride>(A.diced(), rows(A), columns(A),
+      Stride(stride(A)));
+}
+
+/*
+ * Sparse matrix from an Eigen sparse matrix, which must be compressed.
+ */
+template<class T>
+static SparseMatrix<T> make_sparse(const EigenSparse<T>& S) {
+  assert(S.isCompressed());
+  Array<int,1> outer(make_shape(S.outerSize() + 1));
+  Array<int,1> inner(make_shape(S.nonZeros()));
+  Array<T,1> values(make_shape(S.nonZeros()));
+  host_eigen(outer) = Eigen::Map<const Eigen::VectorXi>(S.outerIndexPtr(),
+      S.outerSize() + 1);
+  host_eigen(inner) = Eigen::Map<const Eigen::VectorXi>(S.innerIndexPtr(),
+      S.nonZeros());
+  host_eigen(values) = Eigen::Map<const Eigen::Matrix<T,Eigen::Dynamic,1>>(
+      S.valuePtr(), S.nonZeros());
+  return SparseMatrix<T>(S.rows(), S.cols(), outer, inner, values);
+}
+
+/*
+ * Sparse matrix with the same nonzero pattern as another, and the given
+ * values.
+ */
+template<class T>
+static SparseMatrix<T> make_sparse(const SparseMatrix<T>& S,
+    const Array<T,1>& values) {
+  return SparseMatrix<T>(S.rows(), S.columns(), S.offsets(), S.indices(),
+      values);
+}
+
+/*
+ * Gradient with respect to the nonzero elements of a sparse matrix $S$ for
+ * the product $SB$, i.e. the elements of $GB^\top$ on the nonzero pattern
+ * of $S$.
+ */
+template<class G, class B, class T>
+static SparseMatrix<T> sparse_outer(const G& g, const B& b,
+    const SparseMatrix<T>& S) {
+  auto outer = S.offsets().diced();
+  auto inner = S.indices().diced();
+  Array<T,1> values(make_shape(S.nonzeros()));
+  auto v = host_eigen(values);
+  for (int j = 0; j < S.columns(); ++j) {
+    for (int k = outer[j]; k < outer[j + 1]; ++k) {
+      v(k) = g.row(inner[k]).dot(b.row(j));
+    }
+  }
+  return make_sparse(S, values);
+}
+
+template<class T, class>
+SparseMatrix<T> sparse(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  EigenSparse<T> S = host_eigen(A).sparseView();
+  S.makeCompressed();
+  return make_sparse(S);
+}
+
+template<class T, class>
+SparseMatrix<T> sparse(const int m, const int n, const Array<int,1>& i,
+    const Array<int,1>& j, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(length(i) == length(x));
+  assert(length(j) == length(x));
+  auto i1 = host_eigen(i);
+  auto j1 = host_eigen(j);
+  auto x1 = host_eigen(x);
+  std::vector<Eigen::Triplet<T,int>> triplets;
+  triplets.reserve(length(x));
+  for (int k = 0; k < length(x); ++k) {
+    assert(1 <= i1(k) && i1(k) <= m);
+    assert(1 <= j1(k) && j1(k) <= n);
+    triplets.emplace_back(i1(k) - 1, j1(k) - 1, x1(k));
+  }
+  EigenSparse<T> S(m, n);
+  S.setFromTriplets(triplets.begin(), triplets.end());
+  S.makeCompressed();
+  return make_sparse(S);
+}
+
+template<class T, class>
+Array<T,2> dense(const SparseMatrix<T>& S) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  Array<T,2> A(make_shape(S.rows(), S.columns()), T(0));
+  host_eigen(A) += sparse_eigen(S);
+  return A;
+}
+
+template<class T, class>
+Array<T,1> operator*(const SparseMatrix<T>& S, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(S.columns() == length(x));
+  Array<T,1> y(make_shape(S.rows()));
+  host_eigen(y).noalias() = sparse_eigen(S)*host_eigen(x);
+  return y;
+}
+
+template<class T, class>
+SparseMatrix<T> mul_grad1(const Array<T,1>& g, const Array<T,1>& y,
+    const SparseMatrix<T>& S, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return sparse_outer(host_eigen(g), host_eigen(x), S);
+}
+
+template<class T, class>
+Array<T,1> mul_grad2(const Array<T,1>& g, const Array<T,1>& y,
+    const SparseMatrix<T>& S, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return inner(S, g);
+}
+
+template<class T, class>
+Array<T,2> operator*(const SparseMatrix<T>& S, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(S.columns() == rows(B));
+  Array<T,2> C(make_shape(S.rows(), columns(B)));
+  host_eigen(C).noalias() = sparse_eigen(S)*host_eigen(B);
+  return C;
+}
+
+template<class T, class>
+SparseMatrix<T> mul_grad1(const Array<T,2>& g, const Array<T,2>& C,
+    const SparseMatrix<T>& S, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return sparse_outer(host_eigen(g), host_eigen(B), S);
+}
+
+template<class T, class>
+Array<T,2> mul_grad2(const Array<T,2>& g, const Array<T,2>& C,
+    const SparseMatrix<T>& S, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return inner(S, g);
+}
+
+template<class T, class>
+Array<T,1> inner(const SparseMatrix<T>& S, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(S.rows() == length(x));
+  Array<T,1> y(make_shape(S.columns()));
+  host_eigen(y).noalias() = sparse_eigen(S).transpose()*host_eigen(x);
+  return y;
+}
+
+template<class T, class>
+Array<T,2> inner(const SparseMatrix<T>& S, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(S.rows() == rows(B));
+  Array<T,2> C(make_shape(S.columns(), columns(B)));
+  host_eigen(C).noalias() = sparse_eigen(S).transpose()*host_eigen(B);
+  return C;
+}
+
+template<class T, class>
+SparseCholesky<T> chol(const SparseMatrix<T>& S) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(S.rows() == S.columns());
+  auto n = S.rows();
+  Eigen::SimplicialLLT<EigenSparse<T>,Eigen::Lower,
+      Eigen::AMDOrdering<int>> llt(sparse_eigen(S));
+  EigenSparse<T> L(n, n);
+  Array<int,1> perm(make_shape(n));
+  if (llt.info() == Eigen::Success) {
+    L = llt.matrixL();
+    host_eigen(perm) = llt.permutationP().indices();
+  } else {
+    L.setIdentity();
+    L *= std::numeric_limits<T>::quiet_NaN();
+    host_eigen(perm).setLinSpaced(n, 0, n - 1);
+  }
+  L.makeCompressed();
+  return SparseCholesky<T>(make_sparse(L), perm);
+}
+
+template<class T, class>
+Array<T,1> cholsolve(const SparseCholesky<T>& C, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(C.columns() == length(y));
+  auto L1 = sparse_eigen(C.factor());
+  auto L = L1.template triangularView<Eigen::Lower>();
+  auto U = L1.transpose().template triangularView<Eigen::Upper>();
+  Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> P(
+      host_eigen(C.permutation()));
+  Eigen::Matrix<T,Eigen::Dynamic,1> z = P*host_eigen(y);
+  L.solveInPlace(z);
+  U.solveInPlace(z);
+  Array<T,1> x(shape(y));
+  host_eigen(x) = P.transpose()*z;
+  return x;
+}
+
+template<class T, class>
+Array<T,2> cholsolve(const SparseCholesky<T>& C, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(C.columns() == rows(B));
+  auto L1 = sparse_eigen(C.factor());
+  auto L = L1.template triangularView<Eigen::Lower>();
+  auto U = L1.transpose().template triangularView<Eigen::Upper>();
+  Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> P(
+      host_eigen(C.permutation()));
+  Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> Z = P*host_eigen(B);
+  L.solveInPlace(Z);
+  U.solveInPlace(Z);
+  Array<T,2> X(make_shape(rows(B), columns(B)));
+  host_eigen(X) = P.transpose()*Z;
+  return X;
+}
+
+template<class T, class>
+Array<T,1> triinnersolve(const SparseCholesky<T>& C, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(C.columns() == length(y));
+  auto L1 = sparse_eigen(C.factor());
+  auto L = L1.template triangularView<Eigen::Lower>();
+  auto U = L1.transpose().template triangularView<Eigen::Upper>();
+  Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> P(
+      host_eigen(C.permutation()));
+  Eigen::Matrix<T,Eigen::Dynamic,1> z = host_eigen(y);
+  U.solveInPlace(z);
+  Array<T,1> x(shape(y));
+  host_eigen(x) = P.transpose()*z;
+  return x;
+}
+
+template<class T, class>
+Array<T,0> lcholdet(const SparseCholesky<T>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  auto& L = C.factor();
+  auto outer = L.offsets().diced();
+  auto values = L.data().diced();
+  accumulate_t<T> d = 0;
+  for (int j = 0; j < L.columns(); ++j) {
+    /* the diagonal element is first in each column of the factor */
+    d += std::log(values[outer[j]]);
+  }
+  return T(2*d);
+}
+
+template<class T, class>
+SparseMatrix<T> lcholdet_grad(const Array<T,0>& g, const Array<T,0>& d,
+    const SparseCholesky<T>& C, const SparseMatrix<T>& S) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  auto outer = S.offsets().diced();
+  auto inner = S.indices().diced();
+  auto g1 = g.value();
+  Array<T,1> values(make_shape(S.nonzeros()));
+  auto v = host_eigen(values);
+  Array<T,1> e(make_shape(S.rows()), T(0));
+  for (int j = 0; j < S.columns(); ++j) {
+    if (outer[j] < outer[j + 1]) {
+      /* column j of the inverse */
+      e(j + 1) = T(1);
+      auto u = cholsolve(C, e);
+      e(j + 1) = T(0);
+      auto u1 = host_eigen(u);
+      for (int k = outer[j]; k < outer[j + 1]; ++k) {
+        v(k) = g1*u1(inner[k]);
+      }
+    }
+  }
+  return make_sparse(S, values);
+}
+
+}
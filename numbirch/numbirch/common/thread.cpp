@@ -0,0 +1,139 @@
+/**
+ * @file
+ */
+#include "numbirch/thread.hpp"
+
+#if HAVE_OMP_H
+#include <omp.h>
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+
+namespace numbirch {
+/*
+ * Threading policy. These are set at the start of the program, before
+ * entering any parallel region, and read thereafter.
+ */
+static int max_threads = 0;
+static int max_nested_threads = 1;
+static int64_t parallel_min = 65536;
+static bool numa_local = false;
+
+/*
+ * Memory policy constants, as in `<numaif.h>`, defined here to avoid a
+ * dependency on libnuma.
+ */
+static const int NUMBIRCH_MPOL_PREFERRED = 1;
+static const unsigned NUMBIRCH_MPOL_MF_MOVE = 1u << 1;
+
+void set_max_threads(const int n) {
+  max_threads = std::max(n, 0);
+}
+
+int get_max_threads() {
+#if HAVE_OMP_H
+  return max_threads > 0 ? max_threads : omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+void set_max_nested_threads(const int n) {
+  max_nested_threads = std::max(n, 1);
+#if HAVE_OMP_H
+  if (max_nested_threads > 1) {
+    omp_set_max_active_levels(std::max(omp_get_max_active_levels(), 2));
+  }
+#endif
+}
+
+int get_max_nested_threads() {
+  return max_nested_threads;
+}
+
+void set_parallel_min(const int64_t n) {
+  parallel_min = std::max(n, int64_t(1));
+}
+
+int64_t get_parallel_min() {
+  return parallel_min;
+}
+
+bool in_parallel() {
+#if HAVE_OMP_H
+  return omp_get_active_level() > 0;
+#else
+  return false;
+#endif
+}
+
+int get_op_threads() {
+#if HAVE_OMP_H
+  auto level = omp_get_active_level();
+  if (level == 0) {
+    return get_max_threads();
+  } else if (level == 1) {
+    return max_nested_threads;
+  }
+#endif
+  return 1;
+}
+
+void set_numa_local(const bool on) {
+  numa_local = on;
+}
+
+bool get_numa_local() {
+  return numa_local;
+}
+
+int get_numa_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu = 0, node = 0;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+int get_numa_node(const void* ptr) {
+#if defined(__linux__) && defined(SYS_move_pages)
+  static const uintptr_t page = ::sysconf(_SC_PAGESIZE);
+  void* pages[1] = {reinterpret_cast<void*>(
+      reinterpret_cast<uintptr_t>(ptr) & ~(page - 1))};
+  int status[1] = {-1};
+
+  /* with no target nodes given, move_pages() only queries */
+  if (::syscall(SYS_move_pages, 0, 1, pages, nullptr, status, 0) == 0 &&
+      status[0] >= 0) {
+    return status[0];
+  }
+#endif
+  return -1;
+}
+
+void numa_place(void* ptr, const size_t size) {
+#if defined(__linux__) && defined(SYS_mbind)
+  static const uintptr_t page = ::sysconf(_SC_PAGESIZE);
+  auto from = (reinterpret_cast<uintptr_t>(ptr) + page - 1) & ~(page - 1);
+  auto to = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(page - 1);
+  if (from < to) {
+    const int bits = 8*sizeof(unsigned long);
+    auto node = get_numa_node();
+    std::vector<unsigned long> mask(node/bits + 1, 0);
+    mask[node/bits] = 1ul << (node % bits);
+    ::syscall(SYS_mbind, from, to - from, NUMBIRCH_MPOL_PREFERRED,
+        mask.data(), mask.size()*bits + 1, NUMBIRCH_MPOL_MF_MOVE);
+  }
+#endif
+}
+
+}
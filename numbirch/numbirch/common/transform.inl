@@ -536,6 +536,15 @@ struct lbeta_grad2_functor {
   }
 };
 
+struct lbeta_grad_functor {
+  NUMBIRCH_HOST_DEVICE void operator()(const real g, const real z,
+      const real x, const real y, real& gx, real& gy) const {
+    real d = Eigen::numext::digamma(x + y);
+    gx = g*(Eigen::numext::digamma(x) - d);
+    gy = g*(Eigen::numext::digamma(y) - d);
+  }
+};
+
 struct lchoose_functor {
   NUMBIRCH_HOST_DEVICE auto operator()(const real x, const real y) const {
     return std::lgamma(x + real(1)) - std::lgamma(y + real(1)) -
@@ -561,6 +570,15 @@ struct lchoose_grad2_functor {
   }
 };
 
+struct lchoose_grad_functor {
+  NUMBIRCH_HOST_DEVICE void operator()(const real g, const real z,
+      const real x, const real y, real& gx, real& gy) const {
+    real d = Eigen::numext::digamma(x - y + real(1));
+    gx = g*(Eigen::numext::digamma(x + real(1)) - d);
+    gy = g*(-Eigen::numext::digamma(y + real(1)) + d);
+  }
+};
+
 struct pow_functor {
   NUMBIRCH_HOST_DEVICE auto operator()(const real x, const real y) const {
     return std::pow(x, y);
@@ -581,6 +599,14 @@ struct pow_grad2_functor {
   }
 };
 
+struct pow_grad_functor {
+  NUMBIRCH_HOST_DEVICE void operator()(const real g, const real z,
+      const real x, const real y, real& gx, real& gy) const {
+    gx = g*y*std::pow(x, y - real(1));
+    gy = g*z*std::log(x);
+  }
+};
+
 struct ibeta_functor {
   NUMBIRCH_HOST_DEVICE auto operator()(const real a, const real b,
       const real x) const {
@@ -1111,6 +1137,18 @@ real_t<U> lbeta_grad2(const real_t<T,U>& g, const real_t<T,U>& z, const T& x,
   return aggregate<dimension_v<U>>(transform(g, x, y, lbeta_grad2_functor()));
 }
 
+template<class T, class U, class>
+std::pair<real_t<T>,real_t<U>> lbeta_grad(const real_t<T,U>& g,
+    const real_t<T,U>& z, const T& x, const U& y) {
+  prefetch(g);
+  prefetch(z);
+  prefetch(x);
+  prefetch(y);
+  auto [gx, gy] = transform_grad(g, z, x, y, lbeta_grad_functor());
+  return std::pair<real_t<T>,real_t<U>>(aggregate<dimension_v<T>>(gx),
+      aggregate<dimension_v<U>>(gy));
+}
+
 template<class T, class U, class>
 real_t<T,U> lchoose(const T& x, const U& y) {
   prefetch(x);
@@ -1138,6 +1176,18 @@ real_t<U> lchoose_grad2(const real_t<T,U>& g, const real_t<T,U>& z,
       lchoose_grad2_functor()));
 }
 
+template<class T, class U, class>
+std::pair<real_t<T>,real_t<U>> lchoose_grad(const real_t<T,U>& g,
+    const real_t<T,U>& z, const T& x, const U& y) {
+  prefetch(g);
+  prefetch(z);
+  prefetch(x);
+  prefetch(y);
+  auto [gx, gy] = transform_grad(g, z, x, y, lchoose_grad_functor());
+  return std::pair<real_t<T>,real_t<U>>(aggregate<dimension_v<T>>(gx),
+      aggregate<dimension_v<U>>(gy));
+}
+
 template<class T, class>
 real_t<T> lfact(const T& x) {
   prefetch(x);
@@ -1272,6 +1322,18 @@ real_t<U> pow_grad2(const real_t<T,U>& g, const real_t<T,U>& z, const T& x,
   return aggregate<dimension_v<U>>(transform(g, x, y, pow_grad2_functor()));
 }
 
+template<class T, class U, class>
+std::pair<real_t<T>,real_t<U>> pow_grad(const real_t<T,U>& g,
+    const real_t<T,U>& z, const T& x, const U& y) {
+  prefetch(g);
+  prefetch(z);
+  prefetch(x);
+  prefetch(y);
+  auto [gx, gy] = transform_grad(g, z, x, y, pow_grad_functor());
+  return std::pair<real_t<T>,real_t<U>>(aggregate<dimension_v<T>>(gx),
+      aggregate<dimension_v<U>>(gy));
+}
+
 template<class T, class>
 T rectify(const T& x) {
   prefetch(x);
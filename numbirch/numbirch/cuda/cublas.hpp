@@ -53,10 +53,12 @@ struct cublas {
 };
 template<>
 struct cublas<double> {
+  static constexpr auto type = CUDA_R_64F;
   static constexpr auto copy = cublasDcopy;
   static constexpr auto dot = cublasDdot;
   static constexpr auto gemv = cublasDgemv;
   static constexpr auto gemm = cublasDgemm;
+  static constexpr auto geam = cublasDgeam;
   static constexpr auto trmv = cublasDtrmv;
   static constexpr auto trmm = cublasDtrmm;
   static constexpr auto trsv = cublasDtrsv;
@@ -64,10 +66,12 @@ struct cublas<double> {
 };
 template<>
 struct cublas<float> {
+  static constexpr auto type = CUDA_R_32F;
   static constexpr auto copy = cublasScopy;
   static constexpr auto dot = cublasSdot;
   static constexpr auto gemv = cublasSgemv;
   static constexpr auto gemm = cublasSgemm;
+  static constexpr auto geam = cublasSgeam;
   static constexpr auto trmv = cublasStrmv;
   static constexpr auto trmm = cublasStrmm;
   static constexpr auto trsv = cublasStrsv;
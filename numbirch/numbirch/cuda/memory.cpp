@@ -153,6 +153,22 @@ void array_term(ArrayControl* ctl) {
   }
 }
 
+void array_map(ArrayControl* ctl) {
+  assert(ctl);
+  ctl->streamAlloc = stream;
+  ctl->streamWrite = stream;
+
+  /* register the mapping so that kernels can read it in place */
+  CUDA_CHECK(cudaHostRegister(ctl->map, ctl->mapSize,
+      cudaHostRegisterMapped|cudaHostRegisterReadOnly));
+}
+
+void array_unmap(ArrayControl* ctl) {
+  assert(ctl);
+  array_wait(ctl);
+  CUDA_CHECK(cudaHostUnregister(ctl->map));
+}
+
 void array_resize(ArrayControl* ctl, const size_t size) {
   ctl->buf = numbirch::realloc(ctl->buf, ctl->size, size);
   ctl->size = size;
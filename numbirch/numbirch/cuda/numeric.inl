@@ -4,6 +4,7 @@
 #pragma once
 
 #include "numbirch/utility.hpp"
+#include "numbirch/instrument.hpp"
 #include "numbirch/cuda/cuda.hpp"
 #include "numbirch/cuda/cublas.hpp"
 #include "numbirch/cuda/cusolver.hpp"
@@ -120,8 +121,23 @@ void nan_on_error(T& A, const Array<int,0>& info) {
   }
 }
 
+/*
+ * Copy the elements of one array into another of conforming size, for the
+ * implementation of functions that solve in place in an existing array. Does
+ * nothing if the two are the same array.
+ */
+template<class T, int D>
+static void copy_into(const Array<T,D>& x, Array<T,D>& y) {
+  assert(x.conforms(y));
+  if (&x != &y) {
+    memcpy(y.sliced().data(), y.stride(), x.sliced().data(), x.stride(),
+        y.width(), y.height());
+  }
+}
+
 template<class T, class>
 Array<T,1> operator*(const Array<T,2>& A, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(columns(A) == length(x));
   prefetch(A);
   prefetch(x);
@@ -132,8 +148,35 @@ Array<T,1> operator*(const Array<T,2>& A, const Array<T,1>& x) {
   return y;
 }
 
+template<class T, class>
+void mul(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == length(x));
+  assert(rows(A) == length(y));
+  prefetch(A);
+  prefetch(x);
+  prefetch(y);
+  CUBLAS_CHECK(cublas<T>::gemv(cublasHandle, CUBLAS_OP_N, rows(A), columns(A),
+      scalar<T>::one, sliced(A), stride(A), sliced(x), stride(x), scalar<T>::zero,
+      sliced(y), stride(y)));
+}
+
+template<class T, class>
+void muladd(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == length(x));
+  assert(rows(A) == length(y));
+  prefetch(A);
+  prefetch(x);
+  prefetch(y);
+  CUBLAS_CHECK(cublas<T>::gemv(cublasHandle, CUBLAS_OP_N, rows(A), columns(A),
+      scalar<T>::one, sliced(A), stride(A), sliced(x), stride(x), scalar<T>::one,
+      sliced(y), stride(y)));
+}
+
 template<class T, class>
 Array<T,2> operator*(const Array<T,2>& A, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(columns(A) == rows(B));
   prefetch(A);
   prefetch(B);
@@ -144,8 +187,35 @@ Array<T,2> operator*(const Array<T,2>& A, const Array<T,2>& B) {
   return C;
 }
 
+template<class T, class>
+void mul(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == rows(B));
+  assert(rows(A) == rows(C) && columns(B) == columns(C));
+  prefetch(A);
+  prefetch(B);
+  prefetch(C);
+  CUBLAS_CHECK(cublas<T>::gemm(cublasHandle, CUBLAS_OP_N, CUBLAS_OP_N,
+      rows(C), columns(C), columns(A), scalar<T>::one, sliced(A), stride(A),
+      sliced(B), stride(B), scalar<T>::zero, sliced(C), stride(C)));
+}
+
+template<class T, class>
+void muladd(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == rows(B));
+  assert(rows(A) == rows(C) && columns(B) == columns(C));
+  prefetch(A);
+  prefetch(B);
+  prefetch(C);
+  CUBLAS_CHECK(cublas<T>::gemm(cublasHandle, CUBLAS_OP_N, CUBLAS_OP_N,
+      rows(C), columns(C), columns(A), scalar<T>::one, sliced(A), stride(A),
+      sliced(B), stride(B), scalar<T>::one, sliced(C), stride(C)));
+}
+
 template<class T, class>
 Array<T,2> chol(const Array<T,2>& S) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(S) == columns(S));
   prefetch(S);
   Array<T,2> L(tri(S));
@@ -169,8 +239,22 @@ Array<T,2> chol(const Array<T,2>& S) {
   return L;
 }
 
+template<class T, class>
+Array<T,2> choldowndate(const Array<T,2>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  /* no rank update in cuSOLVER, refactorize instead */
+  return chol(triouter(L) - outer(x));
+}
+
+template<class T, class>
+Array<T,2> choldowndate(const Array<T,2>& L, const Array<T,2>& X) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return chol(triouter(L) - outer(X));
+}
+
 template<class T, class U, class>
 Array<T,2> cholsolve(const Array<T,2>& L, const U& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   prefetch(L);
   Array<T,2> B(diagonal(y, rows(L)));
@@ -185,6 +269,7 @@ Array<T,2> cholsolve(const Array<T,2>& L, const U& y) {
 
 template<class T, class>
 Array<T,1> cholsolve(const Array<T,2>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(y));
   prefetch(L);
@@ -198,8 +283,24 @@ Array<T,1> cholsolve(const Array<T,2>& L, const Array<T,1>& y) {
   return x;
 }
 
+template<class T, class>
+void cholsolve(const Array<T,2>& L, const Array<T,1>& y, Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == length(y));
+  prefetch(L);
+  prefetch(y);
+  copy_into(y, x);
+  Array<int,0> info;
+
+  CUSOLVER_CHECK(cusolverDnXpotrs(cusolverDnHandle, cusolverDnParams,
+      CUBLAS_FILL_MODE_LOWER, length(x), 1, cusolver<T>::CUDA_R, sliced(L),
+      stride(L), cusolver<T>::CUDA_R, sliced(x), length(x), sliced(info)));
+}
+
 template<class T, class>
 Array<T,2> cholsolve(const Array<T,2>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(C));
   prefetch(L);
@@ -214,25 +315,58 @@ Array<T,2> cholsolve(const Array<T,2>& L, const Array<T,2>& C) {
   return B;
 }
 
+template<class T, class>
+void cholsolve(const Array<T,2>& L, const Array<T,2>& C, Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == rows(C));
+  prefetch(L);
+  prefetch(C);
+  copy_into(C, B);
+  Array<int,0> info;
+
+  CUSOLVER_CHECK(cusolverDnXpotrs(cusolverDnHandle, cusolverDnParams,
+      CUBLAS_FILL_MODE_LOWER, rows(B), columns(B), cusolver<T>::CUDA_R,
+      sliced(L), stride(L), cusolver<T>::CUDA_R, sliced(B), stride(B),
+      sliced(info)));
+}
+
+template<class T, class>
+Array<T,2> cholupdate(const Array<T,2>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  /* no rank update in cuSOLVER, refactorize instead */
+  return chol(triouter(L) + outer(x));
+}
+
+template<class T, class>
+Array<T,2> cholupdate(const Array<T,2>& L, const Array<T,2>& X) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return chol(triouter(L) + outer(X));
+}
+
 template<class T, class>
 Array<T,0> dot(const Array<T,1>& x, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(length(x) == length(y));
   prefetch(x);
   prefetch(y);
   Array<T,0> z;
-  CUBLAS_CHECK(cublas<T>::dot(cublasHandle, length(x), sliced(x), stride(x),
-      sliced(y), stride(y), sliced(z)));
+  CUBLAS_CHECK(cublasDotEx(cublasHandle, length(x), sliced(x), cublas<T>::type,
+      stride(x), sliced(y), cublas<T>::type, stride(y), sliced(z),
+      cublas<T>::type, cublas<accumulate_t<T>>::type));
   return z;
 }
 
 template<class T, class>
 Array<T,0> frobenius(const Array<T,2>& x, const Array<T,2>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   ///@todo Avoid temporary
   return sum(hadamard(x, y));
 }
 
 template<class T, class>
 Array<T,1> inner(const Array<T,2>& A, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(A) == length(x));
   prefetch(A);
   prefetch(x);
@@ -243,8 +377,35 @@ Array<T,1> inner(const Array<T,2>& A, const Array<T,1>& x) {
   return y;
 }
 
+template<class T, class>
+void inner(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == length(x));
+  assert(columns(A) == length(y));
+  prefetch(A);
+  prefetch(x);
+  prefetch(y);
+  CUBLAS_CHECK(cublas<T>::gemv(cublasHandle, CUBLAS_OP_T, rows(A), columns(A),
+      scalar<T>::one, sliced(A), stride(A), sliced(x), stride(x), scalar<T>::zero,
+      sliced(y), stride(y)));
+}
+
+template<class T, class>
+void inneradd(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == length(x));
+  assert(columns(A) == length(y));
+  prefetch(A);
+  prefetch(x);
+  prefetch(y);
+  CUBLAS_CHECK(cublas<T>::gemv(cublasHandle, CUBLAS_OP_T, rows(A), columns(A),
+      scalar<T>::one, sliced(A), stride(A), sliced(x), stride(x), scalar<T>::one,
+      sliced(y), stride(y)));
+}
+
 template<class T, class>
 Array<T,2> inner(const Array<T,2>& A, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(A) == rows(B));
   prefetch(A);
   prefetch(B);
@@ -255,8 +416,35 @@ Array<T,2> inner(const Array<T,2>& A, const Array<T,2>& B) {
   return C;
 }
 
+template<class T, class>
+void inner(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == rows(B));
+  assert(columns(A) == rows(C) && columns(B) == columns(C));
+  prefetch(A);
+  prefetch(B);
+  prefetch(C);
+  CUBLAS_CHECK(cublas<T>::gemm(cublasHandle, CUBLAS_OP_T, CUBLAS_OP_N,
+      rows(C), columns(C), rows(A), scalar<T>::one, sliced(A), stride(A),
+      sliced(B), stride(B), scalar<T>::zero, sliced(C), stride(C)));
+}
+
+template<class T, class>
+void inneradd(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == rows(B));
+  assert(columns(A) == rows(C) && columns(B) == columns(C));
+  prefetch(A);
+  prefetch(B);
+  prefetch(C);
+  CUBLAS_CHECK(cublas<T>::gemm(cublasHandle, CUBLAS_OP_T, CUBLAS_OP_N,
+      rows(C), columns(C), rows(A), scalar<T>::one, sliced(A), stride(A),
+      sliced(B), stride(B), scalar<T>::one, sliced(C), stride(C)));
+}
+
 template<class T, class>
 Array<T,2> inv(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(A) == columns(A));
   prefetch(A);
   Array<T,2> LU(A);
@@ -291,6 +479,7 @@ Array<T,2> inv(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,0> ldet(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   prefetch(A);
   Array<T,2> LU(A);
   Array<int,0> info;
@@ -329,6 +518,7 @@ Array<T,0> ldet(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,2> outer(const Array<T,1>& x, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   prefetch(x);
   prefetch(y);
   Array<T,2> A(make_shape(length(x), length(y)));
@@ -345,6 +535,7 @@ Array<T,2> outer(const Array<T,1>& x, const Array<T,1>& y) {
 
 template<class T, class>
 Array<T,2> outer(const Array<T,2>& A, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(columns(A) == columns(B));
   prefetch(A);
   prefetch(B);
@@ -357,6 +548,7 @@ Array<T,2> outer(const Array<T,2>& A, const Array<T,2>& B) {
 
 template<class T, class>
 Array<T,2> phi(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   prefetch(A);
   auto m = rows(A);
   auto n = columns(A);
@@ -370,6 +562,7 @@ Array<T,2> phi(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,2> transpose(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   prefetch(A);
   Array<T,2> B(make_shape(columns(A), rows(A)));
 
@@ -392,6 +585,7 @@ Array<T,2> transpose(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,2> tri(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   prefetch(A);
   auto m = rows(A);
   auto n = columns(A);
@@ -405,6 +599,7 @@ Array<T,2> tri(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,1> triinner(const Array<T,2>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(x));
   prefetch(L);
@@ -416,8 +611,22 @@ Array<T,1> triinner(const Array<T,2>& L, const Array<T,1>& x) {
   return y;
 }
 
+template<class T, class>
+void triinner(const Array<T,2>& L, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == length(x));
+  prefetch(L);
+  prefetch(x);
+  copy_into(x, y);
+  CUBLAS_CHECK(cublas<T>::trmv(cublasHandle, CUBLAS_FILL_MODE_LOWER,
+      CUBLAS_OP_T, CUBLAS_DIAG_NON_UNIT, rows(L), sliced(L), stride(L), sliced(y),
+      stride(y)));
+}
+
 template<class T, class>
 Array<T,2> triinner(const Array<T,2>& L, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(B));
   prefetch(L);
@@ -430,8 +639,24 @@ Array<T,2> triinner(const Array<T,2>& L, const Array<T,2>& B) {
   return C;
 }
 
+template<class T, class>
+void triinner(const Array<T,2>& L, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == rows(B));
+  assert(rows(B) == rows(C) && columns(B) == columns(C));
+  prefetch(L);
+  prefetch(B);
+  prefetch(C);
+  CUBLAS_CHECK(cublas<T>::trmm(cublasHandle, CUBLAS_SIDE_LEFT,
+      CUBLAS_FILL_MODE_LOWER, CUBLAS_OP_T, CUBLAS_DIAG_NON_UNIT, rows(B),
+      columns(B), scalar<T>::one, sliced(L), stride(L), sliced(B), stride(B),
+      sliced(C), stride(C)));
+}
+
 template<class T, class U, class>
 Array<T,2> triinnersolve(const Array<T,2>& L, const U& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   Array<T,2> B(diagonal(y, rows(L)));
 
@@ -444,6 +669,7 @@ Array<T,2> triinnersolve(const Array<T,2>& L, const U& y) {
 
 template<class T, class>
 Array<T,1> triinnersolve(const Array<T,2>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(y));
   Array<T,1> x(y, true);
@@ -454,8 +680,22 @@ Array<T,1> triinnersolve(const Array<T,2>& L, const Array<T,1>& y) {
   return x;
 }
 
+template<class T, class>
+void triinnersolve(const Array<T,2>& L, const Array<T,1>& y,
+    Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == length(y));
+  copy_into(y, x);
+
+  CUBLAS_CHECK(cublas<T>::trsv(cublasHandle, CUBLAS_FILL_MODE_LOWER,
+      CUBLAS_OP_T, CUBLAS_DIAG_NON_UNIT, length(x), sliced(L), stride(L),
+      sliced(x), stride(x)));
+}
+
 template<class T, class>
 Array<T,2> triinnersolve(const Array<T,2>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(C));
   Array<T,2> B(C, true);
@@ -467,8 +707,23 @@ Array<T,2> triinnersolve(const Array<T,2>& L, const Array<T,2>& C) {
   return B;
 }
 
+template<class T, class>
+void triinnersolve(const Array<T,2>& L, const Array<T,2>& C,
+    Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == rows(C));
+  copy_into(C, B);
+
+  CUBLAS_CHECK(cublas<T>::trsm(cublasHandle, CUBLAS_SIDE_LEFT,
+      CUBLAS_FILL_MODE_LOWER, CUBLAS_OP_T, CUBLAS_DIAG_NON_UNIT,
+      rows(B), columns(B), scalar<T>::one, sliced(L), stride(L), sliced(B),
+      stride(B)));
+}
+
 template<class T, class>
 Array<T,1> trimul(const Array<T,2>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(x));
   prefetch(L);
@@ -480,8 +735,22 @@ Array<T,1> trimul(const Array<T,2>& L, const Array<T,1>& x) {
   return y;
 }
 
+template<class T, class>
+void trimul(const Array<T,2>& L, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == length(x));
+  prefetch(L);
+  prefetch(x);
+  copy_into(x, y);
+  CUBLAS_CHECK(cublas<T>::trmv(cublasHandle, CUBLAS_FILL_MODE_LOWER,
+      CUBLAS_OP_N, CUBLAS_DIAG_NON_UNIT, rows(L), sliced(L), stride(L), sliced(y),
+      stride(y)));
+}
+
 template<class T, class>
 Array<T,2> trimul(const Array<T,2>& L, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(B));
   prefetch(L);
@@ -494,8 +763,24 @@ Array<T,2> trimul(const Array<T,2>& L, const Array<T,2>& B) {
   return C;
 }
 
+template<class T, class>
+void trimul(const Array<T,2>& L, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == rows(B));
+  assert(rows(B) == rows(C) && columns(B) == columns(C));
+  prefetch(L);
+  prefetch(B);
+  prefetch(C);
+  CUBLAS_CHECK(cublas<T>::trmm(cublasHandle, CUBLAS_SIDE_LEFT,
+      CUBLAS_FILL_MODE_LOWER, CUBLAS_OP_N, CUBLAS_DIAG_NON_UNIT, rows(B),
+      columns(B), scalar<T>::one, sliced(L), stride(L), sliced(B), stride(B),
+      sliced(C), stride(C)));
+}
+
 template<class T, class>
 Array<T,2> triouter(const Array<T,2>& A, const Array<T,2>& L) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(A) == columns(L));
   prefetch(A);
@@ -510,6 +795,7 @@ Array<T,2> triouter(const Array<T,2>& A, const Array<T,2>& L) {
 
 template<class T, class U, class>
 Array<T,2> trisolve(const Array<T,2>& L, const U& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   Array<T,2> B(diagonal(y, rows(L)));
 
@@ -522,6 +808,7 @@ Array<T,2> trisolve(const Array<T,2>& L, const U& y) {
 
 template<class T, class>
 Array<T,1> trisolve(const Array<T,2>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(y));
   Array<T,1> x(y, true);
@@ -532,8 +819,21 @@ Array<T,1> trisolve(const Array<T,2>& L, const Array<T,1>& y) {
   return x;
 }
 
+template<class T, class>
+void trisolve(const Array<T,2>& L, const Array<T,1>& y, Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == length(y));
+  copy_into(y, x);
+
+  CUBLAS_CHECK(cublas<T>::trsv(cublasHandle, CUBLAS_FILL_MODE_LOWER,
+      CUBLAS_OP_N, CUBLAS_DIAG_NON_UNIT, length(x), sliced(L), stride(L),
+      sliced(x), stride(x)));
+}
+
 template<class T, class>
 Array<T,2> trisolve(const Array<T,2>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(C));
   Array<T,2> B(C, true);
@@ -545,4 +845,116 @@ Array<T,2> trisolve(const Array<T,2>& L, const Array<T,2>& C) {
   return B;
 }
 
+template<class T, class>
+void trisolve(const Array<T,2>& L, const Array<T,2>& C, Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == rows(C));
+  copy_into(C, B);
+
+  CUBLAS_CHECK(cublas<T>::trsm(cublasHandle, CUBLAS_SIDE_LEFT,
+      CUBLAS_FILL_MODE_LOWER, CUBLAS_OP_N, CUBLAS_DIAG_NON_UNIT,
+      rows(B), columns(B), scalar<T>::one, sliced(L), stride(L), sliced(B),
+      stride(B)));
+}
+
+/*
+ * Lower-triangular matrix for a view, for the implementation of functions
+ * on TriView. The cuBLAS triangular routines read only the lower triangle,
+ * so that, unless @p full is true, a view with unit diagonal factor uses the
+ * underlying matrix as is. Otherwise the matrix is materialized.
+ */
+template<class T>
+static Array<T,2> tri_of(const TriView<T>& L, const bool full = false) {
+  auto& A = L.base();
+  auto d = L.diagonal();
+  if (d == T(1)) {
+    return full ? tri(A) : A;
+  } else if (d == T(0.5)) {
+    return phi(A);
+  } else {
+    return tri(A) + diagonal((d - T(1))*A.diagonal());
+  }
+}
+
+template<class T, class>
+Array<T,1> operator*(const TransposeView<T>& A, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return inner(A.base(), x);
+}
+
+template<class T, class>
+Array<T,2> operator*(const TransposeView<T>& A, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return inner(A.base(), B);
+}
+
+template<class T, class>
+Array<T,2> operator*(const Array<T,2>& A, const TransposeView<T>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return outer(A, B.base());
+}
+
+template<class T, class>
+Array<T,2> operator+(const Array<T,2>& A, const TransposeView<T>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == rows(B) && columns(A) == columns(B));
+  prefetch(A);
+  prefetch(B.base());
+  Array<T,2> C(make_shape(rows(A), columns(A)));
+  CUBLAS_CHECK(cublas<T>::geam(cublasHandle, CUBLAS_OP_N, CUBLAS_OP_T,
+      rows(C), columns(C), scalar<T>::one, sliced(A), stride(A),
+      scalar<T>::one, sliced(B.base()), stride(B.base()), sliced(C),
+      stride(C)));
+  return C;
+}
+
+template<class T, class>
+Array<T,1> operator*(const TriView<T>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return trimul(tri_of(L), x);
+}
+
+template<class T, class>
+Array<T,2> operator*(const TriView<T>& L, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return trimul(tri_of(L), B);
+}
+
+template<class T, class>
+Array<T,2> operator*(const Array<T,2>& A, const TriView<T>& L) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return A*tri_of(L, true);
+}
+
+template<class T, class>
+Array<T,1> inner(const TriView<T>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return triinner(tri_of(L), x);
+}
+
+template<class T, class>
+Array<T,2> inner(const TriView<T>& L, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return triinner(tri_of(L), B);
+}
+
+template<class T, class>
+Array<T,2> outer(const Array<T,2>& A, const TriView<T>& L) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return triouter(A, tri_of(L));
+}
+
+template<class T, class>
+Array<T,1> trisolve(const TriView<T>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return trisolve(tri_of(L), y);
+}
+
+template<class T, class>
+Array<T,2> trisolve(const TriView<T>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return trisolve(tri_of(L), C);
+}
+
 }
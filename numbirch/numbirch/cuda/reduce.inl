@@ -4,6 +4,7 @@
 #pragma once
 
 #include "numbirch/cuda/cuda.hpp"
+#include "numbirch/instrument.hpp"
 #include "numbirch/cuda/cub.hpp"
 #include "numbirch/jemalloc/jemalloc.hpp"
 #include "numbirch/common/reduce.inl"
@@ -14,6 +15,7 @@ namespace numbirch {
 
 template<class T, class>
 Array<int,0> count(const T& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   if constexpr (is_arithmetic_v<T>) {
     return count_functor()(x);
   } else {
@@ -24,6 +26,7 @@ Array<int,0> count(const T& x) {
 
 template<class T, class>
 Array<value_t<T>,0> sum(const T& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   if constexpr (is_arithmetic_v<T>) {
     return x;
   } else {
@@ -33,11 +36,14 @@ Array<value_t<T>,0> sum(const T& x) {
     void* tmp = nullptr;
     value_t<T>* dst = nullptr;
     size_t bytes = 0;
-    CUDA_CHECK(cub::DeviceReduce::Sum(tmp, bytes, y, dst, size(x),
-        stream));
+
+    /* the type of the initial value determines the accumulator type */
+    auto init = accumulate_t<value_t<T>>(0);
+    CUDA_CHECK(cub::DeviceReduce::Reduce(tmp, bytes, y, dst, size(x),
+        cub::Sum(), init, stream));
     tmp = device_malloc(bytes);
-    CUDA_CHECK(cub::DeviceReduce::Sum(tmp, bytes, y, sliced(z), size(x),
-        stream));
+    CUDA_CHECK(cub::DeviceReduce::Reduce(tmp, bytes, y, sliced(z), size(x),
+        cub::Sum(), init, stream));
     device_free(tmp, bytes);
     return z;
   }
@@ -6,6 +6,7 @@
 #include "numbirch/cuda/cuda.hpp"
 #include "numbirch/array.hpp"
 #include "numbirch/utility.hpp"
+#include "numbirch/instrument.hpp"
 
 namespace numbirch {
 /*
@@ -47,6 +48,7 @@ __global__ void kernel_for_each(const int m, const int n, T* A, const int ldA,
 }
 template<class Functor>
 auto for_each(const int n, Functor f) {
+  NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
   auto x = Array<decltype(f(0,0)),1>(make_shape(n));
   auto grid = make_grid(1, n);
   auto block = make_block(1, n);
@@ -56,6 +58,7 @@ auto for_each(const int n, Functor f) {
 }
 template<class Functor>
 auto for_each(const int m, const int n, Functor f) {
+  NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
   auto A = Array<decltype(f(0,0)),2>(make_shape(m, n));
   auto grid = make_grid(m, n);
   auto block = make_block(m, n);
@@ -83,6 +86,7 @@ auto transform(const T& x, Functor f) {
   if constexpr (is_arithmetic_v<T>) {
     return f(x);
   } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
     using R = decltype(f(value_t<T>()));
     constexpr int D = dimension_v<T>;
     auto y = Array<R,D>(shape(x));
@@ -118,6 +122,7 @@ auto transform(const T& x, const U& y, Functor f) {
   if constexpr (is_arithmetic_v<T> && is_arithmetic_v<U>) {
     return f(x, y);
   } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
     using R = decltype(f(value_t<T>(),value_t<U>()));
     constexpr int D = dimension_v<implicit_t<T,U>>;
     auto m = width(x, y);
@@ -155,6 +160,7 @@ auto transform(const T& x, const U& y, const V& z, Functor f) {
       is_arithmetic_v<V>) {
     return f(x, y, z);
   } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
     using R = decltype(f(value_t<T>(),value_t<U>(),value_t<V>()));
     constexpr int D = dimension_v<implicit_t<T,U,V>>;
     auto m = width(x, y, z);
@@ -171,6 +177,53 @@ auto transform(const T& x, const U& y, const V& z, Functor f) {
   }
 }
 
+/*
+ * Fused gradient transform. Maps the upstream gradient, result and both
+ * arguments of a binary function to the gradients with respect to both
+ * arguments, in one pass. The functor writes the two gradients through its
+ * last two arguments.
+ */
+template<class G, class Z, class T, class U, class R, class Functor>
+__global__ void kernel_transform_grad(const int m, const int n, const G A,
+    const int ldA, const Z B, const int ldB, const T C, const int ldC,
+    const U D, const int ldD, R E, const int ldE, R F, const int ldF,
+    Functor f) {
+  for (auto j = blockIdx.y*blockDim.y + threadIdx.y; j < n;
+      j += gridDim.y*blockDim.y) {
+    for (auto i = blockIdx.x*blockDim.x + threadIdx.x; i < m;
+        i += gridDim.x*blockDim.x) {
+      f(get(A, i, j, ldA), get(B, i, j, ldB), get(C, i, j, ldC),
+          get(D, i, j, ldD), get(E, i, j, ldE), get(F, i, j, ldF));
+    }
+  }
+}
+template<class G, class Z, class T, class U, class Functor>
+auto transform_grad(const G& g, const Z& z, const T& x, const U& y,
+    Functor f) {
+  if constexpr (is_arithmetic_v<G> && is_arithmetic_v<Z> &&
+      is_arithmetic_v<T> && is_arithmetic_v<U>) {
+    real a, b;
+    f(g, z, x, y, a, b);
+    return std::make_pair(a, b);
+  } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
+    constexpr int D = dimension_v<implicit_t<G,Z,T,U>>;
+    auto m = width(g, z, x, y);
+    auto n = height(g, z, x, y);
+    auto a = Array<real,D>(make_shape<D>(m, n));
+    auto b = Array<real,D>(make_shape<D>(m, n));
+    if (m > 0 && n > 0) {
+      auto grid = make_grid(m, n);
+      auto block = make_block(m, n);
+      CUDA_LAUNCH(kernel_transform_grad<<<grid,block,0,stream>>>(m, n,
+          sliced(g), stride(g), sliced(z), stride(z), sliced(x), stride(x),
+          sliced(y), stride(y), sliced(a), stride(a), sliced(b), stride(b),
+          f));
+    }
+    return std::make_pair(a, b);
+  }
+}
+
 /*
  * Unary gather.
  */
@@ -187,6 +240,7 @@ __global__ void kernel_gather(const int m, const int n, const T A,
 }
 template<class T, class U>
 auto gather(const T& x, const U& i) {
+  NUMBIRCH_INSTRUMENT(__func__);
   constexpr int D = dimension_v<U>;
   auto z = Array<value_t<T>,D>(shape(i));
   auto m = width(i);
@@ -218,6 +272,7 @@ __global__ void kernel_gather(const int m, const int n, const T A,
 }
 template<class T, class U, class V>
 auto gather(const T& x, const U& i, const V& j) {
+  NUMBIRCH_INSTRUMENT(__func__);
   static_assert(dimension_v<U> == dimension_v<V>);
   assert(width(i) == width(j));
   assert(height(i) == height(j));
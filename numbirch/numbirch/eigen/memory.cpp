@@ -3,6 +3,8 @@
  */
 #include "numbirch/memory.hpp"
 #include "numbirch/random.hpp"
+#include "numbirch/thread.hpp"
+#include "numbirch/instrument.hpp"
 #include "numbirch/eigen/eigen.hpp"
 
 #include <cstdlib>
@@ -58,6 +60,9 @@ void array_init(ArrayControl* ctl, const size_t size) {
   assert(ctl);
   ctl->buf = malloc(size);
   ctl->size = size;
+  if (get_numa_local()) {
+    numa_place(ctl->buf, size);
+  }
   ctl->streamAlloc = nullptr;
   ctl->streamWrite = nullptr;
 }
@@ -67,9 +72,22 @@ void array_term(ArrayControl* ctl) {
   free(ctl->buf, ctl->size);
 }
 
+void array_map(ArrayControl* ctl) {
+  assert(ctl);
+  ctl->streamAlloc = nullptr;
+  ctl->streamWrite = nullptr;
+}
+
+void array_unmap(ArrayControl* ctl) {
+  //
+}
+
 void array_resize(ArrayControl* ctl, const size_t size) {
   ctl->buf = numbirch::realloc(ctl->buf, ctl->size, size);
   ctl->size = size;
+  if (get_numa_local()) {
+    numa_place(ctl->buf, size);
+  }
 }
 
 void array_copy(ArrayControl* dst, const ArrayControl* src) {
@@ -86,11 +104,11 @@ bool array_test(ArrayControl* ctl) {
 }
 
 void before_read(ArrayControl* ctl) {
-  //
+  instrument_access(ctl->buf);
 }
 
 void before_write(ArrayControl* ctl) {
-  //
+  instrument_access(ctl->buf);
 }
 
 void after_read(ArrayControl* ctl) {
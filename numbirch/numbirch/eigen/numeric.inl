@@ -4,35 +4,278 @@
 #pragma once
 
 #include "numbirch/utility.hpp"
+#include "numbirch/instrument.hpp"
 #include "numbirch/eigen/eigen.hpp"
+#include "numbirch/eigen/parallel.inl"
 #include "numbirch/numeric.hpp"
 
 namespace numbirch {
+/*
+ * Rank-1 update (sign of 1) or downdate (sign of -1) of a lower-triangular
+ * Cholesky factor in place. The vector x is overwritten. Returns false if a
+ * downdate would result in a matrix that is not positive definite.
+ */
+template<class T, class L, class X>
+static bool cholupdate_inplace(L& L1, X& x1, const T sign) {
+  auto n = L1.rows();
+  for (int j = 0; j < n; ++j) {
+    T l = L1(j, j);
+    T r2 = l*l + sign*x1(j)*x1(j);
+    if (!(r2 > T(0))) {
+      return false;
+    }
+    T r = std::sqrt(r2);
+    T c = r/l;
+    T s = x1(j)/l;
+    L1(j, j) = r;
+    auto m = n - j - 1;
+    if (m > 0) {
+      L1.col(j).tail(m) = (L1.col(j).tail(m) + sign*s*x1.tail(m))/c;
+      x1.tail(m) = c*x1.tail(m) - s*L1.col(j).tail(m);
+    }
+  }
+  return true;
+}
+
+/*
+ * Refactorize $LL^\top + \mathrm{sign} \cdot XX^\top$ into L1, for when
+ * cholupdate_inplace() fails, as a downdate may to rounding error where the
+ * result is still positive definite. Fills L1 with NaN if the result is not
+ * positive definite.
+ */
+template<class T, class X>
+static void cholupdate_refactor(const Array<T,2>& L, const X& X1,
+    const T sign, Array<T,2>& L1) {
+  Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> L0 =
+      make_eigen(L).template triangularView<Eigen::Lower>();
+  Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> S = L0*L0.transpose();
+  S.noalias() += sign*X1*X1.transpose();
+  auto llt = S.llt();
+  if (llt.info() == Eigen::Success) {
+    make_eigen(L1) = llt.matrixL();
+  } else {
+    L1 = T(0.0/0.0);
+  }
+}
+
+/*
+ * Rank-1 update or downdate of a Cholesky factor, for the implementation of
+ * cholupdate() and choldowndate().
+ */
+template<class T>
+static Array<T,2> cholupdate_sign(const Array<T,2>& L, const Array<T,1>& x,
+    const T sign) {
+  assert(rows(L) == columns(L));
+  assert(rows(L) == length(x));
+  Array<T,2> L1(shape(L));
+  auto L2 = make_eigen(L1);
+  L2 = make_eigen(L).template triangularView<Eigen::Lower>();
+  Eigen::Matrix<T,Eigen::Dynamic,1> x1 = make_eigen(x);
+  if (!cholupdate_inplace(L2, x1, sign)) {
+    cholupdate_refactor(L, make_eigen(x), sign, L1);
+  }
+  return L1;
+}
+
+/*
+ * Rank-k update or downdate of a Cholesky factor, for the implementation of
+ * cholupdate() and choldowndate().
+ */
+template<class T>
+static Array<T,2> cholupdate_sign(const Array<T,2>& L, const Array<T,2>& X,
+    const T sign) {
+  assert(rows(L) == columns(L));
+  assert(rows(L) == rows(X));
+  Array<T,2> L1(shape(L));
+  auto L2 = make_eigen(L1);
+  L2 = make_eigen(L).template triangularView<Eigen::Lower>();
+  auto X1 = make_eigen(X);
+  Eigen::Matrix<T,Eigen::Dynamic,1> x1(rows(X));
+  for (int k = 0; k < columns(X); ++k) {
+    x1 = X1.col(k);
+    if (!cholupdate_inplace(L2, x1, sign)) {
+      cholupdate_refactor(L, X1, sign, L1);
+      break;
+    }
+  }
+  return L1;
+}
+
+/*
+ * Product of a lower-triangular view with a vector or matrix, for the
+ * implementation of operator*() and inner() on TriView. With `trans` true,
+ * the view is transposed.
+ */
+template<class T, class X, class Y>
+static void trimul_view(const TriView<T>& L, const X& x, Y& y,
+    const bool trans) {
+  auto A1 = make_eigen(L.base());
+  auto d = L.diagonal();
+  if (trans) {
+    y.noalias() = A1.transpose().template triangularView<Eigen::Upper>()*x;
+  } else {
+    y.noalias() = A1.template triangularView<Eigen::Lower>()*x;
+  }
+  if (d != T(1)) {
+    y += ((d - T(1))*A1.diagonal()).asDiagonal()*x;
+  }
+}
+
+/*
+ * Forward substitution with a lower-triangular view whose diagonal is
+ * scaled, in place, for the implementation of trisolve() on TriView.
+ */
+template<class T, class X>
+static void trisolve_view(const TriView<T>& L, X& x) {
+  auto A1 = make_eigen(L.base());
+  auto d = L.diagonal();
+  if (d == T(1)) {
+    A1.template triangularView<Eigen::Lower>().solveInPlace(x);
+  } else {
+    auto n = A1.rows();
+    for (int j = 0; j < n; ++j) {
+      x.row(j) /= d*A1(j, j);
+      auto m = n - j - 1;
+      if (m > 0) {
+        x.bottomRows(m).noalias() -= A1.col(j).tail(m)*x.row(j);
+      }
+    }
+  }
+}
 
 template<class T, class>
 Array<T,1> operator*(const Array<T,2>& A, const Array<T,1>& x) {
-  assert(columns(A) == length(x));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,1> y(make_shape(rows(A)));
+  mul(A, x, y);
+  return y;
+}
+
+template<class T, class>
+void mul(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == length(x));
+  assert(rows(A) == length(y));
   auto A1 = make_eigen(A);
   auto x1 = make_eigen(x);
   auto y1 = make_eigen(y);
   y1.noalias() = A1*x1;
-  return y;
+}
+
+template<class T, class>
+void muladd(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == length(x));
+  assert(rows(A) == length(y));
+  auto A1 = make_eigen(A);
+  auto x1 = make_eigen(x);
+  auto y1 = make_eigen(y);
+  y1.noalias() += A1*x1;
 }
 
 template<class T, class>
 Array<T,2> operator*(const Array<T,2>& A, const Array<T,2>& B) {
-  assert(columns(A) == rows(B));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> C(make_shape(rows(A), columns(B)));
+  mul(A, B, C);
+  return C;
+}
+
+template<class T, class>
+void mul(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == rows(B));
+  assert(rows(A) == rows(C) && columns(B) == columns(C));
+  auto A1 = make_eigen(A);
+  auto B1 = make_eigen(B);
+  auto C1 = make_eigen(C);
+  kernel_columns(columns(C), int64_t(rows(A))*columns(A)*columns(B),
+      [&](const int j, const int n) {
+        C1.middleCols(j, n).noalias() = A1*B1.middleCols(j, n);
+      });
+}
+
+template<class T, class>
+void muladd(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(A) == rows(B));
+  assert(rows(A) == rows(C) && columns(B) == columns(C));
   auto A1 = make_eigen(A);
   auto B1 = make_eigen(B);
   auto C1 = make_eigen(C);
-  C1.noalias() = A1*B1;
+  kernel_columns(columns(C), int64_t(rows(A))*columns(A)*columns(B),
+      [&](const int j, const int n) {
+        C1.middleCols(j, n).noalias() += A1*B1.middleCols(j, n);
+      });
+}
+
+template<class T, class>
+Array<T,1> operator*(const TransposeView<T>& A, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return inner(A.base(), x);
+}
+
+template<class T, class>
+Array<T,2> operator*(const TransposeView<T>& A, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return inner(A.base(), B);
+}
+
+template<class T, class>
+Array<T,2> operator*(const Array<T,2>& A, const TransposeView<T>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return outer(A, B.base());
+}
+
+template<class T, class>
+Array<T,2> operator+(const Array<T,2>& A, const TransposeView<T>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == rows(B) && columns(A) == columns(B));
+  Array<T,2> C(make_shape(rows(A), columns(A)));
+  auto A1 = make_eigen(A);
+  auto B1 = make_eigen(B.base());
+  auto C1 = make_eigen(C);
+  C1.noalias() = A1 + B1.transpose();
+  return C;
+}
+
+template<class T, class>
+Array<T,1> operator*(const TriView<T>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == length(x));
+  Array<T,1> y(make_shape(rows(L)));
+  auto y1 = make_eigen(y);
+  trimul_view(L, make_eigen(x), y1, false);
+  return y;
+}
+
+template<class T, class>
+Array<T,2> operator*(const TriView<T>& L, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == rows(B));
+  Array<T,2> C(make_shape(rows(L), columns(B)));
+  auto C1 = make_eigen(C);
+  trimul_view(L, make_eigen(B), C1, false);
+  return C;
+}
+
+template<class T, class>
+Array<T,2> operator*(const Array<T,2>& A, const TriView<T>& L) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(A) == rows(L));
+  Array<T,2> C(make_shape(rows(A), columns(L)));
+  auto C1 = make_eigen(C);
+  auto C2 = C1.transpose();
+  trimul_view(L, make_eigen(A).transpose(), C2, true);
   return C;
 }
 
 template<class T, class>
 Array<T,2> chol(const Array<T,2>& S) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(S) == columns(S));
   Array<T,2> L(shape(S));
   auto S1 = make_eigen(S);
@@ -46,8 +289,21 @@ Array<T,2> chol(const Array<T,2>& S) {
   return L;
 }
 
+template<class T, class>
+Array<T,2> choldowndate(const Array<T,2>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return cholupdate_sign(L, x, T(-1));
+}
+
+template<class T, class>
+Array<T,2> choldowndate(const Array<T,2>& L, const Array<T,2>& X) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return cholupdate_sign(L, X, T(-1));
+}
+
 template<class T, class U, class>
 Array<T,2> cholsolve(const Array<T,2>& L, const U& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   Array<T,2> B(make_shape(rows(L), columns(L)));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
@@ -59,73 +315,172 @@ Array<T,2> cholsolve(const Array<T,2>& L, const U& y) {
 
 template<class T, class>
 Array<T,1> cholsolve(const Array<T,2>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  Array<T,1> x(shape(y));
+  cholsolve(L, y, x);
+  return x;
+}
+
+template<class T, class>
+void cholsolve(const Array<T,2>& L, const Array<T,1>& y, Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(y));
-  Array<T,1> x(shape(y));
+  assert(length(x) == length(y));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
   auto U1 = make_eigen(L).transpose().template triangularView<Eigen::Upper>();
+  if (&x != &y) {
+    make_eigen(x) = make_eigen(y);
+  }
   auto x1 = make_eigen(x);
-  auto y1 = make_eigen(y);
-  x1.noalias() = U1.solve(L1.solve(y1));
-  return x;
+  L1.solveInPlace(x1);
+  U1.solveInPlace(x1);
 }
 
 template<class T, class>
 Array<T,2> cholsolve(const Array<T,2>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  Array<T,2> B(shape(C));
+  cholsolve(L, C, B);
+  return B;
+}
+
+template<class T, class>
+void cholsolve(const Array<T,2>& L, const Array<T,2>& C, Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(C));
-  Array<T,2> B(shape(C));
+  assert(rows(B) == rows(C) && columns(B) == columns(C));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
   auto U1 = make_eigen(L).transpose().template triangularView<Eigen::Upper>();
+  if (&B != &C) {
+    make_eigen(B) = make_eigen(C);
+  }
   auto B1 = make_eigen(B);
-  auto C1 = make_eigen(C);
-  B1.noalias() = U1.solve(L1.solve(C1));
-  return B;
+  L1.solveInPlace(B1);
+  U1.solveInPlace(B1);
+}
+
+template<class T, class>
+Array<T,2> cholupdate(const Array<T,2>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return cholupdate_sign(L, x, T(1));
+}
+
+template<class T, class>
+Array<T,2> cholupdate(const Array<T,2>& L, const Array<T,2>& X) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  return cholupdate_sign(L, X, T(1));
 }
 
 template<class T, class>
 Array<T,0> dot(const Array<T,1>& x, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(length(x) == length(y));
+  using U = accumulate_t<T>;
   Array<T,0> z;
   auto x1 = make_eigen(x);
   auto y1 = make_eigen(y);
-  z = x1.dot(y1);
+  z = T(x1.template cast<U>().dot(y1.template cast<U>()));
   return z;
 }
 
 template<class T, class>
 Array<T,0> frobenius(const Array<T,2>& x, const Array<T,2>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  using U = accumulate_t<T>;
   Array<T,0> z;
   auto x1 = make_eigen(x);
   auto y1 = make_eigen(y);
-  z = (x1.array()*y1.array()).sum();
+  z = T((x1.array().template cast<U>()*y1.array().template cast<U>()).sum());
   return z;
 }
 
 template<class T, class>
 Array<T,1> inner(const Array<T,2>& A, const Array<T,1>& x) {
-  assert(rows(A) == length(x));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,1> y(make_shape(columns(A)));
+  inner(A, x, y);
+  return y;
+}
+
+template<class T, class>
+void inner(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == length(x));
+  assert(columns(A) == length(y));
   auto A1 = make_eigen(A);
   auto x1 = make_eigen(x);
   auto y1 = make_eigen(y);
   y1.noalias() = A1.transpose()*x1;
-  return y;
+}
+
+template<class T, class>
+void inneradd(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == length(x));
+  assert(columns(A) == length(y));
+  auto A1 = make_eigen(A);
+  auto x1 = make_eigen(x);
+  auto y1 = make_eigen(y);
+  y1.noalias() += A1.transpose()*x1;
 }
 
 template<class T, class>
 Array<T,2> inner(const Array<T,2>& A, const Array<T,2>& B) {
-  assert(rows(A) == rows(B));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> C(make_shape(columns(A), columns(B)));
+  inner(A, B, C);
+  return C;
+}
+
+template<class T, class>
+void inner(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == rows(B));
+  assert(columns(A) == rows(C) && columns(B) == columns(C));
   auto A1 = make_eigen(A);
   auto B1 = make_eigen(B);
   auto C1 = make_eigen(C);
   C1.noalias() = A1.transpose()*B1;
+}
+
+template<class T, class>
+void inneradd(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(A) == rows(B));
+  assert(columns(A) == rows(C) && columns(B) == columns(C));
+  auto A1 = make_eigen(A);
+  auto B1 = make_eigen(B);
+  auto C1 = make_eigen(C);
+  C1.noalias() += A1.transpose()*B1;
+}
+
+template<class T, class>
+Array<T,1> inner(const TriView<T>& L, const Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(rows(L) == length(x));
+  Array<T,1> y(make_shape(columns(L)));
+  auto y1 = make_eigen(y);
+  trimul_view(L, make_eigen(x), y1, true);
+  return y;
+}
+
+template<class T, class>
+Array<T,2> inner(const TriView<T>& L, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(rows(L) == rows(B));
+  Array<T,2> C(make_shape(columns(L), columns(B)));
+  auto C1 = make_eigen(C);
+  trimul_view(L, make_eigen(B), C1, true);
   return C;
 }
 
 template<class T, class>
 Array<T,2> inv(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(A) == columns(A));
   Array<T,2> B(shape(A));
   auto A1 = make_eigen(A);
@@ -136,12 +491,14 @@ Array<T,2> inv(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,0> ldet(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   auto A1 = make_eigen(A);
   return A1.householderQr().logAbsDeterminant();
 }
 
 template<class T, class>
 Array<T,2> outer(const Array<T,1>& x, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> A(make_shape(length(x), length(y)));
   auto x1 = make_eigen(x);
   auto y1 = make_eigen(y);
@@ -152,6 +509,7 @@ Array<T,2> outer(const Array<T,1>& x, const Array<T,1>& y) {
 
 template<class T, class>
 Array<T,2> outer(const Array<T,2>& A, const Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(columns(A) == columns(B));
   Array<T,2> C(make_shape(rows(A), rows(B)));
   auto A1 = make_eigen(A);
@@ -161,8 +519,21 @@ Array<T,2> outer(const Array<T,2>& A, const Array<T,2>& B) {
   return C;
 }
 
+template<class T, class>
+Array<T,2> outer(const Array<T,2>& A, const TriView<T>& L) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(A) == columns(L));
+  Array<T,2> C(make_shape(rows(A), rows(L)));
+  auto C1 = make_eigen(C);
+  auto C2 = C1.transpose();
+  trimul_view(L, make_eigen(A).transpose(), C2, false);
+  return C;
+}
+
 template<class T, class>
 Array<T,2> phi(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> L(make_shape(rows(A), columns(A)));
   auto A1 = make_eigen(A).template triangularView<Eigen::Lower>();
   auto L1 = make_eigen(L);
@@ -173,6 +544,7 @@ Array<T,2> phi(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,2> transpose(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> B(make_shape(columns(A), rows(A)));
   auto A1 = make_eigen(A);
   auto B1 = make_eigen(B);
@@ -182,6 +554,7 @@ Array<T,2> transpose(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,2> tri(const Array<T,2>& A) {
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> L(make_shape(rows(A), columns(A)));
   auto A1 = make_eigen(A).template triangularView<Eigen::Lower>();
   auto L1 = make_eigen(L);
@@ -191,28 +564,45 @@ Array<T,2> tri(const Array<T,2>& A) {
 
 template<class T, class>
 Array<T,1> triinner(const Array<T,2>& L, const Array<T,1>& x) {
-  assert(rows(L) == length(x));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,1> y(make_shape(columns(L)));
+  triinner(L, x, y);
+  return y;
+}
+
+template<class T, class>
+void triinner(const Array<T,2>& L, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == length(x));
+  assert(columns(L) == length(y));
   auto U1 = make_eigen(L).transpose().template triangularView<Eigen::Upper>();
   auto x1 = make_eigen(x);
   auto y1 = make_eigen(y);
   y1.noalias() = U1*x1;
-  return y;
 }
 
 template<class T, class>
 Array<T,2> triinner(const Array<T,2>& L, const Array<T,2>& B) {
-  assert(rows(L) == rows(B));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> C(make_shape(columns(L), columns(B)));
+  triinner(L, B, C);
+  return C;
+}
+
+template<class T, class>
+void triinner(const Array<T,2>& L, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == rows(B));
+  assert(columns(L) == rows(C) && columns(B) == columns(C));
   auto U1 = make_eigen(L).transpose().template triangularView<Eigen::Upper>();
   auto B1 = make_eigen(B);
   auto C1 = make_eigen(C);
   C1.noalias() = U1*B1;
-  return C;
 }
 
 template<class T, class U, class>
 Array<T,2> triinnersolve(const Array<T,2>& L, const U& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(y));
   Array<T,2> B(make_shape(rows(L), columns(L)));
@@ -225,52 +615,91 @@ Array<T,2> triinnersolve(const Array<T,2>& L, const U& y) {
 
 template<class T, class>
 Array<T,1> triinnersolve(const Array<T,2>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  Array<T,1> x(shape(y));
+  triinnersolve(L, y, x);
+  return x;
+}
+
+template<class T, class>
+void triinnersolve(const Array<T,2>& L, const Array<T,1>& y,
+    Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(y));
-  Array<T,1> x(shape(y));
+  assert(length(x) == length(y));
   auto U1 = make_eigen(L).transpose().template triangularView<Eigen::Upper>();
+  if (&x != &y) {
+    make_eigen(x) = make_eigen(y);
+  }
   auto x1 = make_eigen(x);
-  auto y1 = make_eigen(y);
-  x1.noalias() = U1.solve(y1);
-  return x;
+  U1.solveInPlace(x1);
 }
 
 template<class T, class>
 Array<T,2> triinnersolve(const Array<T,2>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  Array<T,2> B(shape(C));
+  triinnersolve(L, C, B);
+  return B;
+}
+
+template<class T, class>
+void triinnersolve(const Array<T,2>& L, const Array<T,2>& C,
+    Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(C));
-  Array<T,2> B(shape(C));
+  assert(rows(B) == rows(C) && columns(B) == columns(C));
   auto U1 = make_eigen(L).transpose().template triangularView<Eigen::Upper>();
+  if (&B != &C) {
+    make_eigen(B) = make_eigen(C);
+  }
   auto B1 = make_eigen(B);
-  auto C1 = make_eigen(C);
-  B1.noalias() = U1.solve(C1);
-  return B;
+  U1.solveInPlace(B1);
 }
 
 template<class T, class>
 Array<T,1> trimul(const Array<T,2>& L, const Array<T,1>& x) {
-  assert(columns(L) == length(x));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,1> y(make_shape(rows(L)));
+  trimul(L, x, y);
+  return y;
+}
+
+template<class T, class>
+void trimul(const Array<T,2>& L, const Array<T,1>& x, Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(L) == length(x));
+  assert(rows(L) == length(y));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
   auto x1 = make_eigen(x);
   auto y1 = make_eigen(y);
   y1.noalias() = L1*x1;
-  return y;
 }
 
 template<class T, class>
 Array<T,2> trimul(const Array<T,2>& L, const Array<T,2>& B) {
-  assert(columns(L) == rows(B));
+  NUMBIRCH_INSTRUMENT(__func__);
   Array<T,2> C(make_shape(rows(L), columns(B)));
+  trimul(L, B, C);
+  return C;
+}
+
+template<class T, class>
+void trimul(const Array<T,2>& L, const Array<T,2>& B, Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(columns(L) == rows(B));
+  assert(rows(L) == rows(C) && columns(B) == columns(C));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
   auto B1 = make_eigen(B);
   auto C1 = make_eigen(C);
   C1.noalias() = L1*B1;
-  return C;
 }
 
 template<class T, class>
 Array<T,2> triouter(const Array<T,2>& A, const Array<T,2>& L) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(columns(A) == columns(L));
   Array<T,2> C(make_shape(rows(A), rows(L)));
   auto A1 = make_eigen(A);
@@ -282,6 +711,7 @@ Array<T,2> triouter(const Array<T,2>& A, const Array<T,2>& L) {
 
 template<class T, class U, class>
 Array<T,2> trisolve(const Array<T,2>& L, const U& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   Array<T,2> B(make_shape(rows(L), columns(L)));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
@@ -292,25 +722,69 @@ Array<T,2> trisolve(const Array<T,2>& L, const U& y) {
 
 template<class T, class>
 Array<T,1> trisolve(const Array<T,2>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  Array<T,1> x(shape(y));
+  trisolve(L, y, x);
+  return x;
+}
+
+template<class T, class>
+void trisolve(const Array<T,2>& L, const Array<T,1>& y, Array<T,1>& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == length(y));
-  Array<T,1> x(shape(y));
+  assert(length(x) == length(y));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
+  if (&x != &y) {
+    make_eigen(x) = make_eigen(y);
+  }
   auto x1 = make_eigen(x);
-  auto y1 = make_eigen(y);
-  x1.noalias() = L1.solve(y1);
-  return x;
+  L1.solveInPlace(x1);
 }
 
 template<class T, class>
 Array<T,2> trisolve(const Array<T,2>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  Array<T,2> B(shape(C));
+  trisolve(L, C, B);
+  return B;
+}
+
+template<class T, class>
+void trisolve(const Array<T,2>& L, const Array<T,2>& C, Array<T,2>& B) {
+  NUMBIRCH_INSTRUMENT(__func__);
   assert(rows(L) == columns(L));
   assert(columns(L) == rows(C));
-  Array<T,2> B(shape(C));
+  assert(rows(B) == rows(C) && columns(B) == columns(C));
   auto L1 = make_eigen(L).template triangularView<Eigen::Lower>();
+  if (&B != &C) {
+    make_eigen(B) = make_eigen(C);
+  }
   auto B1 = make_eigen(B);
-  auto C1 = make_eigen(C);
-  B1.noalias() = L1.solve(C1);
+  L1.solveInPlace(B1);
+}
+
+template<class T, class>
+Array<T,1> trisolve(const TriView<T>& L, const Array<T,1>& y) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == length(y));
+  Array<T,1> x(shape(y));
+  auto x1 = make_eigen(x);
+  x1 = make_eigen(y);
+  trisolve_view(L, x1);
+  return x;
+}
+
+template<class T, class>
+Array<T,2> trisolve(const TriView<T>& L, const Array<T,2>& C) {
+  NUMBIRCH_INSTRUMENT(__func__);
+  assert(rows(L) == columns(L));
+  assert(columns(L) == rows(C));
+  Array<T,2> B(shape(C));
+  auto B1 = make_eigen(B);
+  B1 = make_eigen(C);
+  trisolve_view(L, B1);
   return B;
 }
 
@@ -0,0 +1,181 @@
+/**
+ * @file
+ *
+ * Multithreaded kernels for the Eigen backend.
+ *
+ * Transforms and reductions over at least get_parallel_min() elements are
+ * divided into blocks of fixed size and the blocks distributed over OpenMP
+ * threads, up to get_op_threads(). When already inside a parallel region,
+ * e.g. one over particles, this is one thread by default, so that the
+ * blocks are processed sequentially by the calling thread and parallel
+ * regions do not nest; see set_max_nested_threads().
+ *
+ * The block size does not depend on the number of threads, and reductions
+ * combine per-block results in block order, so that results are the same
+ * regardless of the number of threads or whether the calling thread is
+ * already inside a parallel region.
+ */
+#pragma once
+
+#include "numbirch/eigen/eigen.hpp"
+#include "numbirch/eigen/special.inl"
+#include "numbirch/thread.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace numbirch {
+/*
+ * Number of elements in each block.
+ */
+static constexpr int64_t parallel_block = 16384;
+
+/*
+ * Base class of functors that must be applied sequentially, e.g. because
+ * they draw from the thread-local random number generator, and results
+ * would otherwise depend on the schedule of threads.
+ */
+struct serial_functor {};
+
+/*
+ * May a kernel with the given functor be divided into blocks?
+ */
+template<class Functor>
+static constexpr bool is_parallel_v = !std::is_base_of_v<serial_functor,
+    Functor>;
+
+/*
+ * Apply a function to blocks of the range `[0, k)`. The function receives
+ * the block number and the first and one-past-last element of the block.
+ */
+template<class Body>
+void kernel_blocks(const int64_t k, Body body) {
+  int64_t nblocks = (k + parallel_block - 1)/parallel_block;
+  int nthreads = int(std::min(int64_t(get_op_threads()), nblocks));
+  #pragma omp parallel for schedule(static) num_threads(nthreads) \
+      if(nthreads > 1)
+  for (int64_t b = 0; b < nblocks; ++b) {
+    body(b, b*parallel_block, std::min(k, (b + 1)*parallel_block));
+  }
+}
+
+/*
+ * Apply a function to a range of the elements of an `m` by `n` matrix,
+ * given as `[a, b)` in column-major order. The function receives the row
+ * and column of each element.
+ */
+template<class Functor>
+void kernel_range(const int m, const int64_t a, const int64_t b,
+    Functor f) {
+  if (a < b) {
+    int j0 = int(a/m);
+    int j1 = int((b - 1)/m);
+    for (int j = j0; j <= j1; ++j) {
+      int i0 = (j == j0) ? int(a - int64_t(j)*m) : 0;
+      int i1 = (j == j1) ? int(b - int64_t(j)*m) : m;
+      for (int i = i0; i < i1; ++i) {
+        f(i, j);
+      }
+    }
+  }
+}
+
+/*
+ * Apply a function to the elements of an `m` by `n` matrix, in blocks
+ * distributed over threads if it is large enough and the functor permits.
+ * The function receives the row and column of each element.
+ */
+template<class Functor, class Body>
+void kernel_parallel(const int m, const int n, Body body) {
+  int64_t k = int64_t(m)*n;
+  if (is_parallel_v<Functor> && k >= get_parallel_min()) {
+    kernel_blocks(k, [&](const int64_t, const int64_t a, const int64_t b) {
+        kernel_range(m, a, b, body);
+      });
+  } else {
+    kernel_range(m, 0, k, body);
+  }
+}
+
+/*
+ * Number of columns in each block of a matrix product.
+ */
+static constexpr int parallel_columns = 64;
+
+/*
+ * Apply a function to blocks of columns of the result of a matrix product,
+ * distributed over threads if the product is large enough. The function
+ * receives the first column and number of columns of the block. The cost is
+ * the number of multiply-adds; the product is divided into blocks if this is
+ * at least `parallel_columns` times get_parallel_min().
+ */
+template<class Body>
+void kernel_columns(const int n, const int64_t cost, Body body) {
+  if (cost >= parallel_columns*get_parallel_min() && n > parallel_columns) {
+    int nblocks = (n + parallel_columns - 1)/parallel_columns;
+    int nthreads = std::min(get_op_threads(), nblocks);
+    #pragma omp parallel for schedule(static) num_threads(nthreads) \
+        if(nthreads > 1)
+    for (int b = 0; b < nblocks; ++b) {
+      int j = b*parallel_columns;
+      body(j, std::min(n - j, parallel_columns));
+    }
+  } else {
+    body(0, n);
+  }
+}
+
+/*
+ * Vectorized kernel, in blocks distributed over threads if the operands are
+ * large enough.
+ */
+template<class R, class Functor, class... Args>
+void kernel_simd_parallel(const int64_t k, Functor f, R C, const Args... A) {
+  if (is_parallel_v<Functor> && k >= get_parallel_min()) {
+    kernel_blocks(k, [&](const int64_t, const int64_t a, const int64_t b) {
+        kernel_simd(b - a, f, C + a, (A + a)...);
+      });
+  } else {
+    kernel_simd(k, f, C, A...);
+  }
+}
+
+/*
+ * Reduce the elements of an `m` by `n` matrix. Each element is mapped with
+ * `f` then summed. Large matrices are divided into blocks that are reduced
+ * in parallel, and the per-block results then summed in block order.
+ */
+template<class R, class T, class Functor>
+R kernel_reduce(const int m, const int n, const T A, const int ldA,
+    Functor f) {
+  using V = std::remove_const_t<std::remove_pointer_t<T>>;
+  int64_t k = int64_t(m)*n;
+  auto reduce = [&](const int64_t a, const int64_t b) {
+    if (contiguous(m, n, ldA)) {
+      return R(Eigen::Map<const Eigen::Array<V,Eigen::Dynamic,1>>(A + a,
+          b - a).unaryExpr(f).template cast<R>().sum());
+    } else {
+      R z = R(0);
+      kernel_range(m, a, b, [&](const int i, const int j) {
+          z = z + R(f(get(A, i, j, ldA)));
+        });
+      return z;
+    }
+  };
+  if (k >= get_parallel_min()) {
+    int64_t nblocks = (k + parallel_block - 1)/parallel_block;
+    auto partial = std::make_unique<R[]>(nblocks);
+    kernel_blocks(k, [&](const int64_t l, const int64_t a, const int64_t b) {
+        partial[l] = reduce(a, b);
+      });
+    R z = R(0);
+    for (int64_t l = 0; l < nblocks; ++l) {
+      z = z + partial[l];
+    }
+    return z;
+  } else {
+    return reduce(0, k);
+  }
+}
+
+}
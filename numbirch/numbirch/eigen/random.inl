@@ -9,13 +9,13 @@
 
 namespace numbirch {
 
-struct simulate_bernoulli_functor {
+struct simulate_bernoulli_functor : serial_functor {
   bool operator()(const real rho) const {
     return std::bernoulli_distribution(rho)(stl<bool>::rng());
   }
 };
 
-struct simulate_beta_functor {
+struct simulate_beta_functor : serial_functor {
   real operator()(const real alpha, const real beta) const {
     real u, v;
     auto& rng = stl<real>::rng();
@@ -25,75 +25,75 @@ struct simulate_beta_functor {
   }
 };
 
-struct simulate_binomial_functor {
+struct simulate_binomial_functor : serial_functor {
   int operator()(const int n, const real rho) const {
     return std::binomial_distribution<int>(n, rho)(stl<int>::rng());
   }
 };
 
-struct simulate_chi_squared_functor {
+struct simulate_chi_squared_functor : serial_functor {
   real operator()(const real nu) const {
     return std::chi_squared_distribution<real>(nu)(stl<real>::rng());
   }
 };
 
-struct simulate_exponential_functor {
+struct simulate_exponential_functor : serial_functor {
   real operator()(const real lambda) const {
     return std::exponential_distribution<real>(lambda)(stl<real>::rng());
   }
 };
 
-struct simulate_gamma_functor {
+struct simulate_gamma_functor : serial_functor {
   real operator()(const real k, const real theta) const {
     return std::gamma_distribution<real>(k, theta)(stl<real>::rng());
   }
 };
 
-struct simulate_gaussian_functor {
+struct simulate_gaussian_functor : serial_functor {
   real operator()(const real mu, const real sigma2) const {
     real sigma = std::sqrt(sigma2);
     return std::normal_distribution<real>(mu, sigma)(stl<real>::rng());
   }
 };
 
-struct simulate_negative_binomial_functor {
+struct simulate_negative_binomial_functor : serial_functor {
   int operator()(const int k, const real rho) const {
     return std::negative_binomial_distribution<int>(k, rho)(stl<int>::rng());
   }
 };
 
-struct simulate_poisson_functor {
+struct simulate_poisson_functor : serial_functor {
   int operator()(const real lambda) const {
     return std::poisson_distribution<int>(lambda)(stl<int>::rng());
   }
 };
 
-struct simulate_uniform_functor {
+struct simulate_uniform_functor : serial_functor {
   real operator()(const real l, const real u) const {
     return std::uniform_real_distribution<real>(l, u)(stl<real>::rng());
   }
 };
 
-struct simulate_uniform_int_functor {
+struct simulate_uniform_int_functor : serial_functor {
   int operator()(const int l, const int u) const {
     return std::uniform_int_distribution<int>(l, u)(stl<int>::rng());
   }
 };
 
-struct simulate_weibull_functor {
+struct simulate_weibull_functor : serial_functor {
   real operator()(const real k, const real lambda) const {
     return std::weibull_distribution<real>(k, lambda)(stl<real>::rng());
   }
 };
 
-struct standard_gaussian_functor {
+struct standard_gaussian_functor : serial_functor {
   real operator()(const int i, const int j) const {
     return std::normal_distribution<real>()(stl<real>::rng());
   }
 };
 
 template<class T>
-struct standard_wishart_functor {
+struct standard_wishart_functor : serial_functor {
   T k;
   int n;
   standard_wishart_functor(const T& k, const int n) :
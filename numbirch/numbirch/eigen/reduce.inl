@@ -4,25 +4,31 @@
 #pragma once
 
 #include "numbirch/reduce.hpp"
+#include "numbirch/instrument.hpp"
 #include "numbirch/eigen/eigen.hpp"
+#include "numbirch/eigen/parallel.inl"
 
 namespace numbirch {
 
 template<class T, class>
 Array<int,0> count(const T& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   if constexpr (is_arithmetic_v<T>) {
     return count_functor()(x);
   } else {
-    return make_eigen(x).unaryExpr(count_functor()).sum();
+    return kernel_reduce<int>(width(x), height(x), sliced(x), stride(x),
+        count_functor());
   }
 }
 
 template<class T, class>
 Array<value_t<T>,0> sum(const T& x) {
+  NUMBIRCH_INSTRUMENT(__func__);
   if constexpr (is_arithmetic_v<T>) {
     return x;
   } else {
-    return make_eigen(x).sum();
+    return value_t<T>(kernel_reduce<accumulate_t<value_t<T>>>(width(x),
+        height(x), sliced(x), stride(x), [](const auto y) { return y; }));
   }
 }
 
@@ -4,8 +4,11 @@
 #pragma once
 
 #include "numbirch/eigen/eigen.hpp"
+#include "numbirch/eigen/special.inl"
+#include "numbirch/eigen/parallel.inl"
 #include "numbirch/array.hpp"
 #include "numbirch/utility.hpp"
+#include "numbirch/instrument.hpp"
 
 namespace numbirch {
 template<class T, int D>
@@ -24,20 +27,20 @@ void prefetch(const T& x) {
 template<class T, class Functor>
 void kernel_for_each(const int m, const int n, T* A, const int ldA,
     Functor f) {
-  for (int j = 0; j < n; ++j) {
-    for (int i = 0; i < m; ++i) {
+  kernel_parallel<Functor>(m, n, [&](const int i, const int j) {
       get(A, i, j, ldA) = f(i, j);
-    }
-  }
+    });
 }
 template<class Functor>
 auto for_each(const int n, Functor f) {
+  NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
   auto x = Array<decltype(f(0,0)),1>(make_shape(n));
   kernel_for_each(1, n, sliced(x), stride(x), f);
   return x;
 }
 template<class Functor>
 auto for_each(const int m, const int n, Functor f) {
+  NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
   auto A = Array<decltype(f(0,0)),2>(make_shape(m, n));
   kernel_for_each(m, n, sliced(A), stride(A), f);
   return A;
@@ -49,17 +52,22 @@ auto for_each(const int m, const int n, Functor f) {
 template<class T, class R, class Functor>
 void kernel_transform(const int m, const int n, const T A, const int ldA, R B,
     const int ldB, Functor f) {
-  for (int j = 0; j < n; ++j) {
-    for (int i = 0; i < m; ++i) {
-      get(B, i, j, ldB) = f(get(A, i, j, ldA));
+  if constexpr (use_simd_v<Functor,T>) {
+    if (contiguous(m, n, ldA) && contiguous(m, n, ldB)) {
+      kernel_simd_parallel(int64_t(m)*n, f, B, A);
+      return;
     }
   }
+  kernel_parallel<Functor>(m, n, [&](const int i, const int j) {
+      get(B, i, j, ldB) = f(get(A, i, j, ldA));
+    });
 }
 template<class T, class Functor>
 auto transform(const T& x, Functor f) {
   if constexpr (is_arithmetic_v<T>) {
     return f(x);
   } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
     using R = decltype(f(value_t<T>()));
     constexpr int D = dimension_v<T>;
     auto m = width(x);
@@ -76,17 +84,23 @@ auto transform(const T& x, Functor f) {
 template<class T, class U, class R, class Functor>
 void kernel_transform(const int m, const int n, const T A, const int ldA,
     const U B, const int ldB, R C, const int ldC, Functor f) {
-  for (int j = 0; j < n; ++j) {
-    for (int i = 0; i < m; ++i) {
-      get(C, i, j, ldC) = f(get(A, i, j, ldA), get(B, i, j, ldB));
+  if constexpr (use_simd_v<Functor,T,U>) {
+    if (contiguous(m, n, ldA) && contiguous(m, n, ldB) &&
+        contiguous(m, n, ldC)) {
+      kernel_simd_parallel(int64_t(m)*n, f, C, A, B);
+      return;
     }
   }
+  kernel_parallel<Functor>(m, n, [&](const int i, const int j) {
+      get(C, i, j, ldC) = f(get(A, i, j, ldA), get(B, i, j, ldB));
+    });
 }
 template<class T, class U, class Functor>
 auto transform(const T& x, const U& y, Functor f) {
   if constexpr (is_arithmetic_v<T> && is_arithmetic_v<U>) {
     return f(x, y);
   } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
     using R = decltype(f(value_t<T>(),value_t<U>()));
     constexpr int D = dimension_v<implicit_t<T,U>>;
     auto m = width(x, y);
@@ -105,12 +119,17 @@ template<class T, class U, class V, class R, class Functor>
 void kernel_transform(const int m, const int n, const T A, const int ldA,
     const U B, const int ldB, const V C, const int ldC, R D, const int ldD,
     Functor f) {
-  for (int j = 0; j < n; ++j) {
-    for (int i = 0; i < m; ++i) {
-      get(D, i, j, ldD) = f(get(A, i, j, ldA), get(B, i, j, ldB),
-          get(C, i, j, ldC));
+  if constexpr (use_simd_v<Functor,T,U,V>) {
+    if (contiguous(m, n, ldA) && contiguous(m, n, ldB) &&
+        contiguous(m, n, ldC) && contiguous(m, n, ldD)) {
+      kernel_simd_parallel(int64_t(m)*n, f, D, A, B, C);
+      return;
     }
   }
+  kernel_parallel<Functor>(m, n, [&](const int i, const int j) {
+      get(D, i, j, ldD) = f(get(A, i, j, ldA), get(B, i, j, ldB),
+          get(C, i, j, ldC));
+    });
 }
 template<class T, class U, class V, class Functor>
 auto transform(const T& x, const U& y, const V& z, Functor f) {
@@ -118,6 +137,7 @@ auto transform(const T& x, const U& y, const V& z, Functor f) {
       is_arithmetic_v<V>) {
     return f(x, y, z);
   } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
     using R = decltype(f(value_t<T>(),value_t<U>(),value_t<V>()));
     constexpr int D = dimension_v<implicit_t<T,U,V>>;
     auto m = width(x, y, z);
@@ -129,6 +149,43 @@ auto transform(const T& x, const U& y, const V& z, Functor f) {
   }
 }
 
+/*
+ * Fused gradient transform. Maps the upstream gradient, result and both
+ * arguments of a binary function to the gradients with respect to both
+ * arguments, in one pass. The functor writes the two gradients through its
+ * last two arguments.
+ */
+template<class G, class Z, class T, class U, class R, class Functor>
+void kernel_transform_grad(const int m, const int n, const G A, const int ldA,
+    const Z B, const int ldB, const T C, const int ldC, const U D,
+    const int ldD, R E, const int ldE, R F, const int ldF, Functor f) {
+  kernel_parallel<Functor>(m, n, [&](const int i, const int j) {
+      f(get(A, i, j, ldA), get(B, i, j, ldB), get(C, i, j, ldC),
+          get(D, i, j, ldD), get(E, i, j, ldE), get(F, i, j, ldF));
+    });
+}
+template<class G, class Z, class T, class U, class Functor>
+auto transform_grad(const G& g, const Z& z, const T& x, const U& y,
+    Functor f) {
+  if constexpr (is_arithmetic_v<G> && is_arithmetic_v<Z> &&
+      is_arithmetic_v<T> && is_arithmetic_v<U>) {
+    real a, b;
+    f(g, z, x, y, a, b);
+    return std::make_pair(a, b);
+  } else {
+    NUMBIRCH_INSTRUMENT(instrument_name<Functor>());
+    constexpr int D = dimension_v<implicit_t<G,Z,T,U>>;
+    auto m = width(g, z, x, y);
+    auto n = height(g, z, x, y);
+    auto a = Array<real,D>(make_shape<D>(m, n));
+    auto b = Array<real,D>(make_shape<D>(m, n));
+    kernel_transform_grad(m, n, sliced(g), stride(g), sliced(z), stride(z),
+        sliced(x), stride(x), sliced(y), stride(y), sliced(a), stride(a),
+        sliced(b), stride(b), f);
+    return std::make_pair(a, b);
+  }
+}
+
 /*
  * Unary gather.
  */
@@ -143,6 +200,7 @@ void kernel_gather(const int m, const int n, const T A, const int ldA,
 }
 template<class T, class U>
 auto gather(const T& x, const U& i) {
+  NUMBIRCH_INSTRUMENT(__func__);
   constexpr int D = dimension_v<U>;
   auto m = width(i);
   auto n = height(i);
@@ -167,6 +225,7 @@ void kernel_gather(const int m, const int n, const T A, const int ldA,
 }
 template<class T, class U, class V>
 auto gather(const T& x, const U& i, const V& j) {
+  NUMBIRCH_INSTRUMENT(__func__);
   constexpr int D = dimension_v<implicit_t<U,V>>;
   auto m = width(i, j);
   auto n = height(i, j);
@@ -13,8 +13,16 @@
 #define INNER_SIG(f, T) \
     template Array<T,1> f(const Array<T,2>&, const Array<T,1>&); \
     template Array<T,2> f(const Array<T,2>&, const Array<T,2>&);
+#define INNER_INTO(f) \
+    INNER_INTO_SIG(f, real)
+#define INNER_INTO_SIG(f, T) \
+    template void f(const Array<T,2>&, const Array<T,1>&, Array<T,1>&); \
+    template void f(const Array<T,2>&, const Array<T,2>&, Array<T,2>&);
 
 namespace numbirch {
 INNER(inner)
 INNER(triinner)
+INNER_INTO(inner)
+INNER_INTO(inneradd)
+INNER_INTO(triinner)
 }
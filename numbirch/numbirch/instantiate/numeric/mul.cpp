@@ -13,8 +13,16 @@
 #define BINARY_MATRIX_SIG(f, T) \
     template Array<T,2> f(const Array<T,2>&, const Array<T,2>&); \
     template Array<T,1> f(const Array<T,2>&, const Array<T,1>&);
+#define BINARY_MATRIX_INTO(f) \
+    BINARY_MATRIX_INTO_SIG(f, real)
+#define BINARY_MATRIX_INTO_SIG(f, T) \
+    template void f(const Array<T,2>&, const Array<T,2>&, Array<T,2>&); \
+    template void f(const Array<T,2>&, const Array<T,1>&, Array<T,1>&);
 
 namespace numbirch {
 BINARY_MATRIX(operator*)
 BINARY_MATRIX(trimul)
+BINARY_MATRIX_INTO(mul)
+BINARY_MATRIX_INTO(muladd)
+BINARY_MATRIX_INTO(trimul)
 }
@@ -15,9 +15,17 @@
     template Array<T,1> f(const Array<T,2>&, const Array<T,1>&); \
     template Array<T,2> f<T,Array<T,0>,int>(const Array<T,2>&, const Array<T,0>&); \
     template Array<T,2> f<T,T,int>(const Array<T,2>&, const T&);
+#define BINARY_MATRIX_INTO(f) \
+    BINARY_MATRIX_INTO_SIG(f, real)
+#define BINARY_MATRIX_INTO_SIG(f, T) \
+    template void f(const Array<T,2>&, const Array<T,2>&, Array<T,2>&); \
+    template void f(const Array<T,2>&, const Array<T,1>&, Array<T,1>&);
 
 namespace numbirch {
 BINARY_MATRIX(cholsolve)
 BINARY_MATRIX(triinnersolve)
 BINARY_MATRIX(trisolve)
+BINARY_MATRIX_INTO(cholsolve)
+BINARY_MATRIX_INTO(triinnersolve)
+BINARY_MATRIX_INTO(trisolve)
 }
@@ -0,0 +1,40 @@
+/**
+ * @file
+ */
+#ifdef BACKEND_CUDA
+#include "numbirch/cuda/numeric.inl"
+#endif
+#ifdef BACKEND_EIGEN
+#include "numbirch/eigen/numeric.inl"
+#endif
+
+#define VIEW(f) \
+    VIEW_SIG(f, real)
+#define VIEW_SIG(f, T) \
+    template Array<T,1> f(const TransposeView<T>&, const Array<T,1>&); \
+    template Array<T,2> f(const TransposeView<T>&, const Array<T,2>&); \
+    template Array<T,2> f(const Array<T,2>&, const TransposeView<T>&); \
+    template Array<T,1> f(const TriView<T>&, const Array<T,1>&); \
+    template Array<T,2> f(const TriView<T>&, const Array<T,2>&); \
+    template Array<T,2> f(const Array<T,2>&, const TriView<T>&);
+#define ADD_VIEW(f) \
+    ADD_VIEW_SIG(f, real)
+#define ADD_VIEW_SIG(f, T) \
+    template Array<T,2> f(const Array<T,2>&, const TransposeView<T>&);
+#define TRI_VIEW(f) \
+    TRI_VIEW_SIG(f, real)
+#define TRI_VIEW_SIG(f, T) \
+    template Array<T,1> f(const TriView<T>&, const Array<T,1>&); \
+    template Array<T,2> f(const TriView<T>&, const Array<T,2>&);
+#define OUTER_VIEW(f) \
+    OUTER_VIEW_SIG(f, real)
+#define OUTER_VIEW_SIG(f, T) \
+    template Array<T,2> f(const Array<T,2>&, const TriView<T>&);
+
+namespace numbirch {
+VIEW(operator*)
+ADD_VIEW(operator+)
+TRI_VIEW(inner)
+TRI_VIEW(trisolve)
+OUTER_VIEW(outer)
+}
@@ -0,0 +1,36 @@
+/**
+ * @file
+ */
+#include "numbirch/common/sparse.inl"
+
+#define SPARSE(T) \
+    template SparseMatrix<T> sparse(const Array<T,2>&); \
+    template SparseMatrix<T> sparse(const int, const int, \
+        const Array<int,1>&, const Array<int,1>&, const Array<T,1>&); \
+    template Array<T,2> dense(const SparseMatrix<T>&); \
+    template Array<T,1> operator*(const SparseMatrix<T>&, const Array<T,1>&); \
+    template Array<T,2> operator*(const SparseMatrix<T>&, const Array<T,2>&); \
+    template SparseMatrix<T> mul_grad1(const Array<T,1>&, const Array<T,1>&, \
+        const SparseMatrix<T>&, const Array<T,1>&); \
+    template SparseMatrix<T> mul_grad1(const Array<T,2>&, const Array<T,2>&, \
+        const SparseMatrix<T>&, const Array<T,2>&); \
+    template Array<T,1> mul_grad2(const Array<T,1>&, const Array<T,1>&, \
+        const SparseMatrix<T>&, const Array<T,1>&); \
+    template Array<T,2> mul_grad2(const Array<T,2>&, const Array<T,2>&, \
+        const SparseMatrix<T>&, const Array<T,2>&); \
+    template Array<T,1> inner(const SparseMatrix<T>&, const Array<T,1>&); \
+    template Array<T,2> inner(const SparseMatrix<T>&, const Array<T,2>&); \
+    template SparseCholesky<T> chol(const SparseMatrix<T>&); \
+    template Array<T,1> cholsolve(const SparseCholesky<T>&, \
+        const Array<T,1>&); \
+    template Array<T,2> cholsolve(const SparseCholesky<T>&, \
+        const Array<T,2>&); \
+    template Array<T,1> triinnersolve(const SparseCholesky<T>&, \
+        const Array<T,1>&); \
+    template Array<T,0> lcholdet(const SparseCholesky<T>&); \
+    template SparseMatrix<T> lcholdet_grad(const Array<T,0>&, \
+        const Array<T,0>&, const SparseCholesky<T>&, const SparseMatrix<T>&);
+
+namespace numbirch {
+SPARSE(real)
+}
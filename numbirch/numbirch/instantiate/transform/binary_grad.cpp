@@ -12,38 +12,45 @@
 #include "numbirch/common/transform.inl"
 #include "numbirch/common/random.inl"
 
-#define BINARY_GRAD(f, R) \
-    BINARY_GRAD_FIRST(f, R, real) \
-    BINARY_GRAD_FIRST(f, R, int) \
-    BINARY_GRAD_FIRST(f, R, bool)
-#define BINARY_GRAD_FIRST(f, R, T) \
-    BINARY_GRAD_SECOND(f, R, T, real) \
-    BINARY_GRAD_SECOND(f, R, T, int) \
-    BINARY_GRAD_SECOND(f, R, T, bool)
-#define BINARY_GRAD_SECOND(f, R, T, U) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 2), NUMBIRCH_ARRAY(U, 2)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 1), NUMBIRCH_ARRAY(U, 1)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 0), NUMBIRCH_ARRAY(U, 0)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 0), U) \
-    BINARY_GRAD_SIG(f, R, T, NUMBIRCH_ARRAY(U, 0)) \
-    BINARY_GRAD_SIG(f, R, T, U) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 2), NUMBIRCH_ARRAY(U, 0)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 0), NUMBIRCH_ARRAY(U, 2)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 2), U) \
-    BINARY_GRAD_SIG(f, R, T, NUMBIRCH_ARRAY(U, 2)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 1), NUMBIRCH_ARRAY(U, 0)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 0), NUMBIRCH_ARRAY(U, 1)) \
-    BINARY_GRAD_SIG(f, R, NUMBIRCH_ARRAY(T, 1), U) \
-    BINARY_GRAD_SIG(f, R, T, NUMBIRCH_ARRAY(U, 1))
+#define BINARY_GRAD(f, R) BINARY_GRAD_TYPES(f, R, BINARY_GRAD_SIG)
+#define BINARY_GRAD_TYPES(f, R, SIG) \
+    BINARY_GRAD_FIRST(f, R, SIG, real) \
+    BINARY_GRAD_FIRST(f, R, SIG, int) \
+    BINARY_GRAD_FIRST(f, R, SIG, bool)
+#define BINARY_GRAD_FIRST(f, R, SIG, T) \
+    BINARY_GRAD_SECOND(f, R, SIG, T, real) \
+    BINARY_GRAD_SECOND(f, R, SIG, T, int) \
+    BINARY_GRAD_SECOND(f, R, SIG, T, bool)
+#define BINARY_GRAD_SECOND(f, R, SIG, T, U) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 2), NUMBIRCH_ARRAY(U, 2)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 1), NUMBIRCH_ARRAY(U, 1)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 0), NUMBIRCH_ARRAY(U, 0)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 0), U) \
+    SIG(f, R, T, NUMBIRCH_ARRAY(U, 0)) \
+    SIG(f, R, T, U) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 2), NUMBIRCH_ARRAY(U, 0)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 0), NUMBIRCH_ARRAY(U, 2)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 2), U) \
+    SIG(f, R, T, NUMBIRCH_ARRAY(U, 2)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 1), NUMBIRCH_ARRAY(U, 0)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 0), NUMBIRCH_ARRAY(U, 1)) \
+    SIG(f, R, NUMBIRCH_ARRAY(T, 1), U) \
+    SIG(f, R, T, NUMBIRCH_ARRAY(U, 1))
 #define BINARY_GRAD_SIG(f, R, T, U) \
     template real_t<T> f ## 1<T,U,int>(const real_t<T,U>&, const R<T,U>&, \
         const T&, const U&); \
     template real_t<U> f ## 2<T,U,int>(const real_t<T,U>&, const R<T,U>&, \
         const T&, const U&);
+#define BINARY_GRAD_FUSED_SIG(f, R, T, U) \
+    template std::pair<real_t<T>,real_t<U>> f<T,U,int>(const real_t<T,U>&, \
+        const R<T,U>&, const T&, const U&);
 
 #define BINARY_ARITHMETIC_GRAD(f) BINARY_GRAD(f, implicit_t)
 #define BINARY_REAL_GRAD(f) BINARY_GRAD(f, real_t)
 #define BINARY_BOOL_GRAD(f) BINARY_GRAD(f, bool_t)
+#define BINARY_REAL_GRAD_FUSED(f) \
+    BINARY_GRAD(f, real_t) \
+    BINARY_GRAD_TYPES(f, real_t, BINARY_GRAD_FUSED_SIG)
 
 namespace numbirch {
 BINARY_BOOL_GRAD(and_grad)
@@ -58,9 +65,9 @@ BINARY_ARITHMETIC_GRAD(add_grad)
 BINARY_ARITHMETIC_GRAD(copysign_grad)
 BINARY_ARITHMETIC_GRAD(div_grad)
 BINARY_ARITHMETIC_GRAD(hadamard_grad)
-BINARY_REAL_GRAD(lbeta_grad)
-BINARY_REAL_GRAD(lchoose_grad)
+BINARY_REAL_GRAD_FUSED(lbeta_grad)
+BINARY_REAL_GRAD_FUSED(lchoose_grad)
 BINARY_REAL_GRAD(lgamma_grad)
-BINARY_REAL_GRAD(pow_grad)
+BINARY_REAL_GRAD_FUSED(pow_grad)
 BINARY_ARITHMETIC_GRAD(sub_grad)
 }
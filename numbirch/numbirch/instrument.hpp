@@ -0,0 +1,305 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @internal
+ *
+ * @def NUMBIRCH_INSTRUMENT
+ *
+ * Record a call of the enclosing function, under the given name, while
+ * instrumentation is enabled. The name must have static storage duration,
+ * e.g. `__func__`.
+ *
+ * @ingroup instrument
+ */
+#define NUMBIRCH_INSTRUMENT(name) numbirch::Instrument instrument_(name)
+
+namespace numbirch {
+/**
+ * Instrumentation record for a single function.
+ *
+ * @ingroup instrument
+ */
+struct InstrumentRecord {
+  /**
+   * Function name.
+   */
+  std::string name;
+
+  /**
+   * Number of calls.
+   */
+  int64_t calls;
+
+  /**
+   * Number of bytes of arrays allocated during calls.
+   */
+  int64_t bytes;
+
+  /**
+   * Cumulative wall time of calls, in seconds.
+   */
+  double seconds;
+};
+
+/**
+ * Instrumentation snapshot.
+ *
+ * @ingroup instrument
+ */
+struct InstrumentSnapshot {
+  /**
+   * Records for each function called, in order of name.
+   */
+  std::vector<InstrumentRecord> functions;
+
+  /**
+   * Number of array allocations.
+   */
+  int64_t allocations;
+
+  /**
+   * Number of bytes of arrays allocated.
+   */
+  int64_t bytes;
+
+  /**
+   * Number of bytes of arrays live.
+   */
+  int64_t live;
+
+  /**
+   * Peak number of bytes of arrays live.
+   */
+  int64_t peak;
+
+  /**
+   * Number of copy-on-write copies of arrays.
+   */
+  int64_t copies;
+
+  /**
+   * Number of bytes copied by copy-on-write copies of arrays.
+   */
+  int64_t copied;
+
+  /**
+   * Number of retries on contention for the control block of an array, e.g.
+   * from concurrent copy-on-write of the same array by multiple threads.
+   */
+  int64_t contentions;
+
+  /**
+   * Number of accesses to array buffers from a thread on the same NUMA node
+   * as the buffer. Accesses are counted as each operation obtains a buffer
+   * for reading or writing, under the Eigen backend only, and only if
+   * enabled with set_instrument_numa().
+   */
+  int64_t local;
+
+  /**
+   * Number of accesses to array buffers from a thread on a different NUMA
+   * node to the buffer.
+   */
+  int64_t remote;
+};
+
+/**
+ * Enable or disable instrumentation.
+ *
+ * @ingroup instrument
+ *
+ * @param on Enable?
+ *
+ * Instrumentation is disabled by default, and costs little more than a
+ * branch per call when disabled. It should be enabled at the start of the
+ * program, before any arrays are allocated, so that live and peak memory
+ * are accurate.
+ */
+void set_instrument(const bool on);
+
+/**
+ * Is instrumentation enabled?
+ *
+ * @ingroup instrument
+ */
+bool get_instrument();
+
+/**
+ * Enable or disable counting of local and remote NUMA accesses, while
+ * instrumentation is enabled.
+ *
+ * @ingroup instrument
+ *
+ * @param on Enable?
+ *
+ * Counting is disabled by default. Each access queries the operating system
+ * for the NUMA nodes of the buffer and calling thread, which adds two system
+ * calls to every operation, and so skews the wall times recorded for
+ * functions.
+ */
+void set_instrument_numa(const bool on);
+
+/**
+ * Is counting of local and remote NUMA accesses enabled?
+ *
+ * @ingroup instrument
+ */
+bool get_instrument_numa();
+
+/**
+ * Snapshot instrumentation counters.
+ *
+ * @ingroup instrument
+ *
+ * Wall times are inclusive: the time of a function includes that of the
+ * functions that it calls. Under the CUDA backend, they include only the
+ * time to enqueue a kernel, not to run it, unless the function waits on the
+ * result.
+ */
+InstrumentSnapshot instrument_snapshot();
+
+/**
+ * Reset instrumentation counters. Live memory is not reset, and peak memory
+ * is reset to live memory.
+ *
+ * @ingroup instrument
+ */
+void instrument_reset();
+
+/**
+ * @internal
+ *
+ * Record an array allocation.
+ *
+ * @ingroup instrument
+ *
+ * @param size Size, in bytes.
+ */
+void instrument_alloc(const size_t size);
+
+/**
+ * @internal
+ *
+ * Record an array deallocation.
+ *
+ * @ingroup instrument
+ *
+ * @param size Size, in bytes.
+ */
+void instrument_free(const size_t size);
+
+/**
+ * @internal
+ *
+ * Record a copy-on-write copy of an array.
+ *
+ * @ingroup instrument
+ *
+ * @param size Size, in bytes.
+ */
+void instrument_copy(const size_t size);
+
+/**
+ * @internal
+ *
+ * Record a retry on contention for the control block of an array.
+ *
+ * @ingroup instrument
+ */
+void instrument_contention();
+
+/**
+ * @internal
+ *
+ * Record an access to an array buffer, as local or remote according to the
+ * NUMA nodes of the buffer and calling thread.
+ *
+ * @ingroup instrument
+ *
+ * @param ptr Buffer.
+ *
+ * This queries the operating system for both nodes, so is relatively
+ * expensive, but only while both instrumentation and NUMA counting are
+ * enabled, see set_instrument_numa().
+ */
+void instrument_access(const void* ptr);
+
+/**
+ * @internal
+ *
+ * Name under which to record a function given by a type name.
+ *
+ * @ingroup instrument
+ *
+ * @param name Type name, as from `std::type_info::name()`.
+ *
+ * @return Demangled name, without namespace and without any `_functor`
+ * suffix, with static storage duration.
+ */
+const char* instrument_name(const char* name);
+
+/**
+ * @internal
+ *
+ * Name under which to record a function given by a functor type, e.g. for
+ * transformations.
+ *
+ * @ingroup instrument
+ *
+ * @tparam Functor Functor type.
+ */
+template<class Functor>
+const char* instrument_name() {
+  static const char* name = instrument_name(typeid(Functor).name());
+  return name;
+}
+
+/**
+ * @internal
+ *
+ * Scoped record of a function call. Use NUMBIRCH_INSTRUMENT() rather than
+ * constructing directly.
+ *
+ * @ingroup instrument
+ */
+class Instrument {
+public:
+  /**
+   * Constructor. Starts the call.
+   *
+   * @param name Function name, with static storage duration.
+   */
+  Instrument(const char* name);
+
+  /**
+   * Destructor. Ends the call.
+   */
+  ~Instrument();
+
+private:
+  /**
+   * Record for the function, `nullptr` if instrumentation is disabled.
+   */
+  void* record;
+
+  /**
+   * Record of the calling function, if any.
+   */
+  void* caller;
+
+  /**
+   * Start time, in nanoseconds.
+   */
+  int64_t start;
+};
+
+}
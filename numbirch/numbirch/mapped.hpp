@@ -0,0 +1,186 @@
+/**
+ * @file
+ *
+ * NumBirch memory-mapped array interface.
+ */
+#pragma once
+
+#include "numbirch/array/Array.hpp"
+
+#include <string>
+#include <cstdint>
+
+namespace numbirch {
+/**
+ * @internal
+ *
+ * Header of an array file.
+ *
+ * @ingroup array
+ *
+ * An array file is this 64-byte header followed immediately by the
+ * elements of the array, in column-major order without padding, in the
+ * native byte order of the machine that wrote it.
+ */
+struct MappedHeader {
+  /**
+   * Magic number, `NBARRAY` followed by a null character.
+   */
+  char magic[8];
+
+  /**
+   * Element type, see mapped_type().
+   */
+  int32_t type;
+
+  /**
+   * Number of dimensions, zero to two.
+   */
+  int32_t ndims;
+
+  /**
+   * Number of rows, one for a scalar.
+   */
+  int64_t rows;
+
+  /**
+   * Number of columns, one for a scalar or vector.
+   */
+  int64_t columns;
+
+  /**
+   * Reserved, zero.
+   */
+  char reserved[32];
+};
+static_assert(sizeof(MappedHeader) == 64, "MappedHeader must be 64 bytes");
+
+/**
+ * @internal
+ *
+ * Element type code of an array file.
+ *
+ * @ingroup array
+ */
+template<class T>
+constexpr int32_t mapped_type() {
+  if constexpr (std::is_same_v<T,double>) {
+    return 1;
+  } else if constexpr (std::is_same_v<T,float>) {
+    return 2;
+  } else if constexpr (std::is_same_v<T,int>) {
+    return 3;
+  } else {
+    static_assert(std::is_same_v<T,bool>, "unsupported element type");
+    return 4;
+  }
+}
+
+/**
+ * @internal
+ *
+ * Map an array file read-only.
+ *
+ * @ingroup array
+ *
+ * @param path File path.
+ * @param type Expected element type code.
+ * @param ndims Expected number of dimensions.
+ * @param[out] rows Number of rows.
+ * @param[out] columns Number of columns.
+ * @param[out] ctl Control block over the elements, or `nullptr` if the
+ * array is empty.
+ *
+ * @return True on success, false if the file cannot be read or mapped, or
+ * has a different element type or number of dimensions to those expected.
+ */
+bool map_file(const std::string& path, const int32_t type,
+    const int32_t ndims, int& rows, int& columns, ArrayControl*& ctl);
+
+/**
+ * @internal
+ *
+ * Write an array file.
+ *
+ * @ingroup array
+ *
+ * @param path File path.
+ * @param type Element type code.
+ * @param ndims Number of dimensions.
+ * @param rows Number of rows.
+ * @param columns Number of columns.
+ * @param data Elements, contiguous in column-major order.
+ * @param size Size of elements, in bytes.
+ *
+ * @return True on success, false if the file cannot be written.
+ */
+bool write_file(const std::string& path, const int32_t type,
+    const int32_t ndims, const int rows, const int columns,
+    const void* data, const size_t size);
+
+/**
+ * Map an array file read-only, without copying its elements.
+ *
+ * @ingroup array
+ *
+ * @tparam T Element type.
+ * @tparam D Number of dimensions.
+ *
+ * @param path File path.
+ * @param[out] x Array over the elements of the file. The file's pages are
+ * loaded on demand, and are shared between all copies of the array, and
+ * with other processes that map the same file. Writing to the array copies
+ * its elements first, as for copy-on-write.
+ *
+ * @return True on success, false if the file cannot be read, or does not
+ * hold an array of element type @p T and @p D dimensions, in which case
+ * @p x is unchanged.
+ *
+ * @see write_mapped()
+ */
+template<class T, int D>
+bool read_mapped(const std::string& path, Array<T,D>& x) {
+  int m = 0, n = 0;
+  ArrayControl* ctl = nullptr;
+  if (!map_file(path, mapped_type<T>(), D, m, n, ctl)) {
+    return false;
+  }
+  ArrayShape<D> shp;
+  if constexpr (D == 0) {
+    shp = make_shape();
+  } else if constexpr (D == 1) {
+    shp = make_shape(m);
+  } else {
+    shp = make_shape(m, n);
+  }
+  if (ctl) {
+    x = Array<T,D>(ctl, shp, false);
+  } else {
+    x = Array<T,D>(shp);
+  }
+  return true;
+}
+
+/**
+ * Write an array file, for later use with read_mapped().
+ *
+ * @ingroup array
+ *
+ * @tparam T Element type.
+ * @tparam D Number of dimensions.
+ *
+ * @param path File path.
+ * @param x Array.
+ *
+ * @return True on success, false if the file cannot be written.
+ */
+template<class T, int D>
+bool write_mapped(const std::string& path, const Array<T,D>& x) {
+  /* copy to ensure contiguous elements */
+  Array<T,D> y(x, true);
+  return write_file(path, mapped_type<T>(), D, y.rows(), y.columns(),
+      y.volume() > 0 ? static_cast<const T*>(y.diced()) : nullptr,
+      y.volume()*sizeof(T));
+}
+
+}
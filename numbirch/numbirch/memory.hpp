@@ -159,6 +159,25 @@ void array_init(ArrayControl* ctl, const size_t size);
  */
 void array_term(ArrayControl* ctl);
 
+/**
+ * Initialize an array with a read-only buffer already mapped from a file.
+ * 
+ * @ingroup memory
+ * 
+ * @param ctl Control block, with its buffer and size set.
+ */
+void array_map(ArrayControl* ctl);
+
+/**
+ * Finalize an array with a read-only buffer mapped from a file, before it is
+ * unmapped.
+ * 
+ * @ingroup memory
+ * 
+ * @param ctl Control block.
+ */
+void array_unmap(ArrayControl* ctl);
+
 /**
  * Resize an array.
  * 
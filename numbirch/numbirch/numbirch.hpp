@@ -25,16 +25,33 @@
  * 
  * @defgroup linalg Linear algebra
  * Linear algebra functions, such as matrix multiplication and solve().
+ * Several have variants that write their result into an existing array
+ * rather than allocating a new one, such as mul() for operator*() and
+ * muladd() to accumulate into the existing array. These allocate only if
+ * the destination shares its buffer with another array, which is first
+ * copied.
  * 
  * @defgroup linalg_grad Gradients
  * @ingroup linalg
  * Gradients of linear algebra functions.
  * 
+ * @defgroup sparse Sparse matrices
+ * Sparse matrices in compressed sparse column format, with products,
+ * Cholesky factorization and their gradients.
+ * 
  * @defgroup random Random number generation
  * Batched pseudorandom number generation.
  *
  * @defgroup memory Memory
  * Asynchronous unified memory management.
+ *
+ * @defgroup thread Threading
+ * Policy for the number of threads used by a single operation, inside and
+ * outside of parallel regions, and placement of memory on NUMA nodes.
+ * 
+ * @defgroup instrument Instrumentation
+ * Optional counters of calls, wall time, allocations and copy-on-write
+ * copies.
  * 
  * @defgroup trait Type traits
  * Type traits used for SFINAE.
@@ -47,3 +64,7 @@
 #include "numbirch/transform.hpp"
 #include "numbirch/reduce.hpp"
 #include "numbirch/random.hpp"
+#include "numbirch/sparse.hpp"
+#include "numbirch/mapped.hpp"
+#include "numbirch/thread.hpp"
+#include "numbirch/instrument.hpp"
@@ -7,6 +7,7 @@
 #include "numbirch/array/Scalar.hpp"
 #include "numbirch/array/Vector.hpp"
 #include "numbirch/array/Matrix.hpp"
+#include "numbirch/array/MatrixView.hpp"
 #include "numbirch/array.hpp"
 #include "numbirch/transform.hpp"
 
@@ -210,6 +211,38 @@ real_t<U> mul_grad2(const real_t<T,U>& g, const implicit_t<T,U>& z, const T& x,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> operator*(const Array<T,2>& A, const Array<T,1>& x);
 
+/**
+ * Matrix-vector multiplication into an existing vector.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param x Vector $x$.
+ * @param[out] y Vector $y$, overwritten with the result $y = Ax$. It must
+ * have conforming size, and must not alias @p A or @p x.
+ * 
+ * @see operator*()
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void mul(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y);
+
+/**
+ * Matrix-vector multiply-accumulate.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param x Vector $x$.
+ * @param[out] y Vector $y$, updated in place to $y + Ax$. It must have
+ * conforming size, and must not alias @p A or @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void muladd(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y);
+
 /**
  * Gradient of operator*().
  * 
@@ -265,6 +298,146 @@ Array<T,1> mul_grad2(const Array<T,1>& g, const Array<T,1>& y,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> operator*(const Array<T,2>& A, const Array<T,2>& B);
 
+/**
+ * Transposed-matrix-vector multiplication.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Transposed view of a matrix $A$.
+ * @param x Vector $x$.
+ * 
+ * @return Result $y = A^\top x$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> operator*(const TransposeView<T>& A, const Array<T,1>& x);
+
+/**
+ * Transposed-matrix-matrix multiplication.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Transposed view of a matrix $A$.
+ * @param B Matrix $B$.
+ * 
+ * @return Result $C = A^\top B$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> operator*(const TransposeView<T>& A, const Array<T,2>& B);
+
+/**
+ * Matrix-transposed-matrix multiplication.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param B Transposed view of a matrix $B$.
+ * 
+ * @return Result $C = AB^\top$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> operator*(const Array<T,2>& A, const TransposeView<T>& B);
+
+/**
+ * Matrix-transposed-matrix addition.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param B Transposed view of a matrix $B$.
+ * 
+ * @return Result $C = A + B^\top$.
+ * 
+ * With $B = A$ this forms the symmetric matrix $A + A^\top$ in one pass,
+ * without materializing $A^\top$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> operator+(const Array<T,2>& A, const TransposeView<T>& B);
+
+/**
+ * Triangular-matrix-vector multiplication.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular view $L$.
+ * @param x Vector $x$.
+ * 
+ * @return Result $y = Lx$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> operator*(const TriView<T>& L, const Array<T,1>& x);
+
+/**
+ * Triangular-matrix-matrix multiplication.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular view $L$.
+ * @param B Matrix $B$.
+ * 
+ * @return Result $C = LB$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> operator*(const TriView<T>& L, const Array<T,2>& B);
+
+/**
+ * Matrix-triangular-matrix multiplication.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param L Lower-triangular view $L$.
+ * 
+ * @return Result $C = AL$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> operator*(const Array<T,2>& A, const TriView<T>& L);
+
+/**
+ * Matrix-matrix multiplication into an existing matrix.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param B Matrix $B$.
+ * @param[out] C Matrix $C$, overwritten with the result $C = AB$. It must
+ * have conforming size, and must not alias @p A or @p B.
+ * 
+ * @see operator*()
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void mul(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C);
+
+/**
+ * Matrix-matrix multiply-accumulate.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param B Matrix $B$.
+ * @param[out] C Matrix $C$, updated in place to $C + AB$. It must have
+ * conforming size, and must not alias @p A or @p B.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void muladd(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C);
+
 /**
  * Gradient of operator*().
  * 
@@ -364,8 +537,139 @@ template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> chol_grad(const Array<T,2>& g, const Array<T,2>& L,
     const Array<T,2>& S) {
   auto A = phi(triinner(L, g));
-  return phi(transpose(triinnersolve(L, transpose(triinnersolve(L, A +
-      transpose(A))))));
+  /* the result of the outer triinnersolve() is symmetric, so need not be
+   * transposed */
+  return phi(triinnersolve(L, transpose(triinnersolve(L, A +
+      transpose_view(A)))));
+}
+
+/**
+ * Rank-1 downdate of a Cholesky factorization.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular Cholesky factor $L$ of the symmetric positive
+ * definite matrix $S = LL^\top$.
+ * @param x Vector $x$.
+ * 
+ * @return Lower-triangular Cholesky factor $L'$ such that
+ * $L'L'^\top = LL^\top - xx^\top$. If the downdate fails, as it may to
+ * rounding error when the result is nearly singular, then the result is
+ * refactorized as by chol(). If the result is not positive definite, then
+ * $L'$ is filled with NaN.
+ * 
+ * This costs $O(n^2)$, where refactorizing with chol() costs $O(n^3)$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> choldowndate(const Array<T,2>& L, const Array<T,1>& x);
+
+/**
+ * Gradient of choldowndate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param x Vector $x$.
+ * 
+ * @return Gradient with respect to @p L.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> choldowndate_grad1(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,1>& x) {
+  /* chol_grad() does not use its last argument, L1 stands in for S' */
+  auto G = chol_grad(g, L1, L1);
+  return tri((G + transpose_view(G))*L);
+}
+
+/**
+ * Gradient of choldowndate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param x Vector $x$.
+ * 
+ * @return Gradient with respect to @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> choldowndate_grad2(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,1>& x) {
+  auto G = chol_grad(g, L1, L1);
+  return -((G + transpose_view(G))*x);
+}
+
+/**
+ * Rank-$k$ downdate of a Cholesky factorization.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular Cholesky factor $L$ of the symmetric positive
+ * definite matrix $S = LL^\top$.
+ * @param X Matrix $X$ with $k$ columns.
+ * 
+ * @return Lower-triangular Cholesky factor $L'$ such that
+ * $L'L'^\top = LL^\top - XX^\top$. If the downdate fails, as it may to
+ * rounding error when the result is nearly singular, then the result is
+ * refactorized as by chol(). If the result is not positive definite, then
+ * $L'$ is filled with NaN.
+ * 
+ * This costs $O(kn^2)$, where refactorizing with chol() costs $O(n^3)$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> choldowndate(const Array<T,2>& L, const Array<T,2>& X);
+
+/**
+ * Gradient of choldowndate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param X Matrix $X$.
+ * 
+ * @return Gradient with respect to @p L.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> choldowndate_grad1(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,2>& X) {
+  auto G = chol_grad(g, L1, L1);
+  return tri((G + transpose_view(G))*L);
+}
+
+/**
+ * Gradient of choldowndate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param X Matrix $X$.
+ * 
+ * @return Gradient with respect to @p X.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> choldowndate_grad2(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,2>& X) {
+  auto G = chol_grad(g, L1, L1);
+  return -((G + transpose_view(G))*X);
 }
 
 /**
@@ -446,8 +750,7 @@ Array<T,2> cholsolve_grad1(const Array<T,2>& g, const Array<T,2>& B,
     const Array<T,2>& L, const U& y) {
   auto gy = cholsolve(L, g);
   auto gS = outer(gy, -B);
-  auto gL = tri((gS + transpose(gS))*L);
-  return gL;
+  return tri((gS + transpose_view(gS))*L);
 }
 
 /**
@@ -489,6 +792,22 @@ Array<T,0> cholsolve_grad2(const Array<T,2>& g, const Array<T,2>& B,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> cholsolve(const Array<T,2>& L, const Array<T,1>& y);
 
+/**
+ * Matrix-vector solve via the Cholesky factorization, into an existing vector.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular Cholesky factor $L$ of the matrix $S$.
+ * @param y Vector $y$.
+ * @param[out] x Vector $x$, overwritten with the solution of $x$ in
+ * $Sx = y$. It must have conforming size, and must not alias @p L. It
+ * may be @p y itself, to solve in place.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void cholsolve(const Array<T,2>& L, const Array<T,1>& y, Array<T,1>& x);
+
 /**
  * Gradient of cholsolve().
  * 
@@ -509,8 +828,7 @@ Array<T,2> cholsolve_grad1(const Array<T,1>& g, const Array<T,1>& x,
     const Array<T,2>& L, const Array<T,1>& y) {
   auto gy = cholsolve(L, g);
   auto gS = outer(gy, -x);
-  auto gL = tri((gS + transpose(gS))*L);
-  return gL;
+  return tri((gS + transpose_view(gS))*L);
 }
 
 /**
@@ -550,6 +868,22 @@ Array<T,1> cholsolve_grad2(const Array<T,1>& g, const Array<T,1>& x,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> cholsolve(const Array<T,2>& L, const Array<T,2>& C);
 
+/**
+ * Matrix-matrix solve via the Cholesky factorization, into an existing matrix.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular Cholesky factor $L$ of the matrix $S$.
+ * @param C Matrix $C$.
+ * @param[out] B Matrix $B$, overwritten with the solution of $B$ in
+ * $SB = C$. It must have conforming size, and must not alias @p L. It
+ * may be @p C itself, to solve in place.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void cholsolve(const Array<T,2>& L, const Array<T,2>& C, Array<T,2>& B);
+
 /**
  * Gradient of cholsolve().
  * 
@@ -570,8 +904,7 @@ Array<T,2> cholsolve_grad1(const Array<T,2>& g, const Array<T,2>& B,
     const Array<T,2>& L, const Array<T,2>& C) {
   auto gC = cholsolve(L, g);
   auto gS = outer(gC, -B);
-  auto gL = tri((gS + transpose(gS))*L);
-  return gL;
+  return tri((gS + transpose_view(gS))*L);
 }
 
 /**
@@ -595,6 +928,129 @@ Array<T,2> cholsolve_grad2(const Array<T,2>& g, const Array<T,2>& B,
   return cholsolve(L, g);
 }
 
+/**
+ * Rank-1 update of a Cholesky factorization.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular Cholesky factor $L$ of the symmetric positive
+ * definite matrix $S = LL^\top$.
+ * @param x Vector $x$.
+ * 
+ * @return Lower-triangular Cholesky factor $L'$ such that
+ * $L'L'^\top = LL^\top + xx^\top$.
+ * 
+ * This costs $O(n^2)$, where refactorizing with chol() costs $O(n^3)$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> cholupdate(const Array<T,2>& L, const Array<T,1>& x);
+
+/**
+ * Gradient of cholupdate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param x Vector $x$.
+ * 
+ * @return Gradient with respect to @p L.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> cholupdate_grad1(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,1>& x) {
+  /* chol_grad() does not use its last argument, L1 stands in for S' */
+  auto G = chol_grad(g, L1, L1);
+  return tri((G + transpose_view(G))*L);
+}
+
+/**
+ * Gradient of cholupdate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param x Vector $x$.
+ * 
+ * @return Gradient with respect to @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> cholupdate_grad2(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,1>& x) {
+  auto G = chol_grad(g, L1, L1);
+  return (G + transpose_view(G))*x;
+}
+
+/**
+ * Rank-$k$ update of a Cholesky factorization.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular Cholesky factor $L$ of the symmetric positive
+ * definite matrix $S = LL^\top$.
+ * @param X Matrix $X$ with $k$ columns.
+ * 
+ * @return Lower-triangular Cholesky factor $L'$ such that
+ * $L'L'^\top = LL^\top + XX^\top$.
+ * 
+ * This costs $O(kn^2)$, where refactorizing with chol() costs $O(n^3)$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> cholupdate(const Array<T,2>& L, const Array<T,2>& X);
+
+/**
+ * Gradient of cholupdate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param X Matrix $X$.
+ * 
+ * @return Gradient with respect to @p L.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> cholupdate_grad1(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,2>& X) {
+  auto G = chol_grad(g, L1, L1);
+  return tri((G + transpose_view(G))*L);
+}
+
+/**
+ * Gradient of cholupdate().
+ * 
+ * @ingroup linalg_grad
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param L1 Result $L'$.
+ * @param L Lower-triangular Cholesky factor $L$.
+ * @param X Matrix $X$.
+ * 
+ * @return Gradient with respect to @p X.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> cholupdate_grad2(const Array<T,2>& g, const Array<T,2>& L1,
+    const Array<T,2>& L, const Array<T,2>& X) {
+  auto G = chol_grad(g, L1, L1);
+  return (G + transpose_view(G))*X;
+}
+
 /**
  * Vector dot product.
  * 
@@ -795,6 +1251,36 @@ Array<T,2> frobenius_grad2(const Array<T,0>& g, const Array<T,0>& z,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> inner(const Array<T,2>& A, const Array<T,1>& x);
 
+/**
+ * Matrix-vector inner product into an existing vector.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param x Vector $x$.
+ * @param[out] y Vector $y$, overwritten with the result $y = A^\top x$. It must
+ * have conforming size, and must not alias @p A or @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void inner(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y);
+
+/**
+ * Matrix-vector inner product, accumulated.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param x Vector $x$.
+ * @param[out] y Vector $y$, updated in place to $y + A^\top x$. It must have
+ * conforming size, and must not alias @p A or @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void inneradd(const Array<T,2>& A, const Array<T,1>& x, Array<T,1>& y);
+
 /**
  * Gradient of inner().
  * 
@@ -867,7 +1353,7 @@ Array<T,2> inner(const Array<T,2>& A) {
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> inner_grad(const Array<T,2>& g, const Array<T,2>& B,
     const Array<T,2>& A) {
-  return A*(g + transpose(g));
+  return A*(g + transpose_view(g));
 }
 
 /**
@@ -885,6 +1371,66 @@ Array<T,2> inner_grad(const Array<T,2>& g, const Array<T,2>& B,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> inner(const Array<T,2>& A, const Array<T,2>& B);
 
+/**
+ * Triangular-matrix-vector inner product.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular view $L$.
+ * @param x Vector $x$.
+ * 
+ * @return Result $y = L^\top x$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> inner(const TriView<T>& L, const Array<T,1>& x);
+
+/**
+ * Triangular-matrix-matrix inner product.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular view $L$.
+ * @param B Matrix $B$.
+ * 
+ * @return Result $C = L^\top B$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> inner(const TriView<T>& L, const Array<T,2>& B);
+
+/**
+ * Matrix-matrix inner product into an existing matrix.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param B Matrix $B$.
+ * @param[out] C Matrix $C$, overwritten with the result $C = A^\top B$. It must
+ * have conforming size, and must not alias @p A or @p B.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void inner(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C);
+
+/**
+ * Matrix-matrix inner product, accumulated.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param B Matrix $B$.
+ * @param[out] C Matrix $C$, updated in place to $C + A^\top B$. It must have
+ * conforming size, and must not alias @p A or @p B.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void inneradd(const Array<T,2>& A, const Array<T,2>& B, Array<T,2>& C);
+
 /**
  * Gradient of inner().
  * 
@@ -1098,7 +1644,7 @@ Array<T,2> outer(const Array<T,1>& x) {
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> outer_grad(const Array<T,2>& g, const Array<T,2>& B,
     const Array<T,1>& x) {
-  return (g + transpose(g))*x;
+  return (g + transpose_view(g))*x;
 }
 
 /**
@@ -1188,7 +1734,7 @@ Array<T,2> outer(const Array<T,2>& A) {
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> outer_grad(const Array<T,2>& g, const Array<T,2>& B,
     const Array<T,2>& A) {
-  return (g + transpose(g))*A;
+  return (g + transpose_view(g))*A;
 }
 
 /**
@@ -1206,6 +1752,21 @@ Array<T,2> outer_grad(const Array<T,2>& g, const Array<T,2>& B,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> outer(const Array<T,2>& A, const Array<T,2>& B);
 
+/**
+ * Matrix-triangular-matrix outer product.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param A Matrix $A$.
+ * @param L Lower-triangular view $L$.
+ * 
+ * @return Result $C = AL^\top$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> outer(const Array<T,2>& A, const TriView<T>& L);
+
 /**
  * Gradient of outer().
  * 
@@ -1396,6 +1957,21 @@ Array<T,2> tri_grad(const Array<T,2>& g, const Array<T,2>& L,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> triinner(const Array<T,2>& L, const Array<T,1>& x);
 
+/**
+ * Lower-triangular-matrix-vector inner product into an existing vector.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param x Vector $x$.
+ * @param[out] y Vector $y$, overwritten with the result $y = L^\top x$. It must
+ * have conforming size, and must not alias @p L or @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void triinner(const Array<T,2>& L, const Array<T,1>& x, Array<T,1>& y);
+
 /**
  * Gradient of triinner().
  * 
@@ -1468,7 +2044,7 @@ Array<T,2> triinner(const Array<T,2>& L) {
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> triinner_grad(const Array<T,2>& g, const Array<T,2>& C,
     const Array<T,2>& L) {
-  return tri(trimul(L, g + transpose(g)));
+  return tri(trimul(L, g + transpose_view(g)));
 }
 
 /**
@@ -1486,6 +2062,21 @@ Array<T,2> triinner_grad(const Array<T,2>& g, const Array<T,2>& C,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> triinner(const Array<T,2>& L, const Array<T,2>& B);
 
+/**
+ * Lower-triangular-matrix-matrix inner product into an existing matrix.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param B Matrix $B$.
+ * @param[out] C Matrix $C$, overwritten with the result $C = L^\top B$. It must
+ * have conforming size, and must not alias @p L or @p B.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void triinner(const Array<T,2>& L, const Array<T,2>& B, Array<T,2>& C);
+
 /**
  * Gradient of triinner().
  * 
@@ -1602,6 +2193,23 @@ Array<T,0> triinnersolve_grad2(const Array<T,2>& g, const Array<T,2>& B,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> triinnersolve(const Array<T,2>& L, const Array<T,1>& x);
 
+/**
+ * Lower-triangular-matrix-vector inner solve into an existing vector.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param y Vector $y$.
+ * @param[out] x Vector $x$, overwritten with the solution of $x$ in
+ * $L^\top x = y$. It must have conforming size, and must not alias @p L.
+ * It may be @p y itself, to solve in place.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void triinnersolve(const Array<T,2>& L, const Array<T,1>& y,
+    Array<T,1>& x);
+
 /**
  * Gradient of triinnersolve().
  * 
@@ -1657,6 +2265,23 @@ Array<T,1> triinnersolve_grad2(const Array<T,1>& g, const Array<T,1>& x,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> triinnersolve(const Array<T,2>& L, const Array<T,2>& C);
 
+/**
+ * Lower-triangular-matrix-matrix inner solve into an existing matrix.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param C Matrix $C$.
+ * @param[out] B Matrix $B$, overwritten with the solution of $B$ in
+ * $L^\top B = C$. It must have conforming size, and must not alias @p L.
+ * It may be @p C itself, to solve in place.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void triinnersolve(const Array<T,2>& L, const Array<T,2>& C,
+    Array<T,2>& B);
+
 /**
  * Gradient of triinnersolve().
  * 
@@ -1747,6 +2372,21 @@ Array<T,2> triinv_grad(const Array<T,2>& g, const Array<T,2>& B,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> trimul(const Array<T,2>& L, const Array<T,1>& x);
 
+/**
+ * Lower-triangular-matrix-vector product into an existing vector.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param x Vector $x$.
+ * @param[out] y Vector $y$, overwritten with the result $y = Lx$. It must
+ * have conforming size, and must not alias @p L or @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void trimul(const Array<T,2>& L, const Array<T,1>& x, Array<T,1>& y);
+
 /**
  * Gradient of trimul().
  * 
@@ -1802,6 +2442,21 @@ Array<T,1> trimul_grad2(const Array<T,1>& g, const Array<T,1>& y,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> trimul(const Array<T,2>& L, const Array<T,2>& B);
 
+/**
+ * Lower-triangular-matrix-matrix product into an existing matrix.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param B Matrix $B$.
+ * @param[out] C Matrix $C$, overwritten with the result $C = LB$. It must
+ * have conforming size, and must not alias @p L or @p B.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void trimul(const Array<T,2>& L, const Array<T,2>& B, Array<T,2>& C);
+
 /**
  * Gradient of trimul().
  * 
@@ -1874,7 +2529,7 @@ Array<T,2> triouter(const Array<T,2>& L) {
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> triouter_grad(const Array<T,2>& g, const Array<T,2>& C,
     const Array<T,2>& L) {
-  return tri((g + transpose(g))*L);
+  return tri((g + transpose_view(g))*L);
 }
 
 /**
@@ -2008,6 +2663,22 @@ Array<T,0> trisolve_grad2(const Array<T,2>& g, const Array<T,2>& B,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,1> trisolve(const Array<T,2>& L, const Array<T,1>& y);
 
+/**
+ * Lower-triangular-matrix-vector solve into an existing vector.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param y Vector $y$.
+ * @param[out] x Vector $x$, overwritten with the solution of $x$ in
+ * $Lx = y$. It must have conforming size, and must not alias @p L. It
+ * may be @p y itself, to solve in place.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void trisolve(const Array<T,2>& L, const Array<T,1>& y, Array<T,1>& x);
+
 /**
  * Gradient of trisolve().
  * 
@@ -2063,6 +2734,52 @@ Array<T,1> trisolve_grad2(const Array<T,1>& g, const Array<T,1>& x,
 template<class T, class = std::enable_if_t<is_real_v<T>,int>>
 Array<T,2> trisolve(const Array<T,2>& L, const Array<T,2>& C);
 
+/**
+ * Triangular-matrix-vector solve.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular view $L$.
+ * @param y Vector $y$.
+ * 
+ * @return Solution of $x$ in $Lx = y$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> trisolve(const TriView<T>& L, const Array<T,1>& y);
+
+/**
+ * Triangular-matrix-matrix solve.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular view $L$.
+ * @param C Matrix $C$.
+ * 
+ * @return Solution of $B$ in $LB = C$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> trisolve(const TriView<T>& L, const Array<T,2>& C);
+
+/**
+ * Lower-triangular-matrix-matrix solve into an existing matrix.
+ * 
+ * @ingroup linalg
+ * 
+ * @tparam T Floating point type.
+ * 
+ * @param L Lower-triangular matrix $L$.
+ * @param C Matrix $C$.
+ * @param[out] B Matrix $B$, overwritten with the solution of $B$ in
+ * $LB = C$. It must have conforming size, and must not alias @p L. It
+ * may be @p C itself, to solve in place.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+void trisolve(const Array<T,2>& L, const Array<T,2>& C, Array<T,2>& B);
+
 /**
  * Gradient of trisolve().
  * 
@@ -36,6 +36,55 @@ void seed(const int s);
  */
 void seed();
 
+/**
+ * Draw a seed for the pseudorandom number generators of a new team of
+ * threads.
+ *
+ * @ingroup random
+ *
+ * @return Seed to pass to seed_team() from each thread of the new team, or
+ * -1 if none is required.
+ *
+ * Call this on the thread that starts a parallel region, before it starts.
+ * The threads of a nested team, i.e. one started inside another parallel
+ * region, may be new threads, or threads last used for another team, so
+ * that their generators are not seeded by seed(), and their state does not
+ * carry over from one parallel region to the next. A seed is then drawn
+ * from the generator of the calling thread, so that the streams of the new
+ * team are determined by it. Outside of any parallel region, the threads of
+ * the new team are those seeded by seed(), and -1 is returned.
+ */
+int team_seed();
+
+/**
+ * Seed the pseudorandom number generators of the calling thread only.
+ *
+ * @ingroup random
+ *
+ * @param s Seed.
+ * @param n Stream number.
+ *
+ * The generators are seeded with the pair $(s, n)$, so that different
+ * stream numbers give different streams for the same seed. This allows a
+ * computation to be repeated with the same random numbers regardless of the
+ * thread on which it runs.
+ */
+void seed_thread(const int s, const int n);
+
+/**
+ * Seed the pseudorandom number generators of a thread in a new team.
+ *
+ * @ingroup random
+ *
+ * @param s Seed, as returned by team_seed().
+ *
+ * Call this on each thread at the start of the parallel region. The first
+ * thread, being the thread that started the region, keeps its generators,
+ * while the $n$th of the others is seeded as by seed_thread() with the pair
+ * $(s, n)$. Does nothing if $s$ is -1.
+ */
+void seed_team(const int s);
+
 /**
  * Simulate a Bernoulli distribution.
  *
@@ -0,0 +1,294 @@
+/**
+ * @file
+ *
+ * NumBirch sparse matrix interface.
+ */
+#pragma once
+
+#include "numbirch/array/Array.hpp"
+#include "numbirch/array/Scalar.hpp"
+#include "numbirch/array/Vector.hpp"
+#include "numbirch/array/Matrix.hpp"
+#include "numbirch/array/SparseMatrix.hpp"
+
+namespace numbirch {
+/**
+ * Convert a dense matrix to a sparse matrix.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param A Matrix $A$.
+ *
+ * @return Sparse matrix with the nonzero elements of $A$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+SparseMatrix<T> sparse(const Array<T,2>& A);
+
+/**
+ * Construct a sparse matrix from triplets.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param m Number of rows.
+ * @param n Number of columns.
+ * @param i Row indices, one-based.
+ * @param j Column indices, one-based.
+ * @param x Values.
+ *
+ * @return Sparse matrix $S$ with $S_{i_kj_k} = x_k$. Values with the same
+ * row and column index are summed.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+SparseMatrix<T> sparse(const int m, const int n, const Array<int,1>& i,
+    const Array<int,1>& j, const Array<T,1>& x);
+
+/**
+ * Convert a sparse matrix to a dense matrix.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param S Sparse matrix $S$.
+ *
+ * @return Dense matrix with the same elements as $S$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> dense(const SparseMatrix<T>& S);
+
+/**
+ * Sparse-matrix-vector multiplication.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param S Sparse matrix $S$.
+ * @param x Vector $x$.
+ *
+ * @return Result $y = Sx$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> operator*(const SparseMatrix<T>& S, const Array<T,1>& x);
+
+/**
+ * Gradient of operator*().
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param g Gradient with respect to result.
+ * @param y Result $y = Sx$.
+ * @param S Sparse matrix $S$.
+ * @param x Vector $x$.
+ *
+ * @return Gradient with respect to the nonzero elements of @p S, as a sparse
+ * matrix with the same nonzero pattern.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+SparseMatrix<T> mul_grad1(const Array<T,1>& g, const Array<T,1>& y,
+    const SparseMatrix<T>& S, const Array<T,1>& x);
+
+/**
+ * Gradient of operator*().
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param g Gradient with respect to result.
+ * @param y Result $y = Sx$.
+ * @param S Sparse matrix $S$.
+ * @param x Vector $x$.
+ *
+ * @return Gradient with respect to @p x.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> mul_grad2(const Array<T,1>& g, const Array<T,1>& y,
+    const SparseMatrix<T>& S, const Array<T,1>& x);
+
+/**
+ * Sparse-matrix-matrix multiplication.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param S Sparse matrix $S$.
+ * @param B Matrix $B$.
+ *
+ * @return Result $C = SB$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> operator*(const SparseMatrix<T>& S, const Array<T,2>& B);
+
+/**
+ * Gradient of operator*().
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param g Gradient with respect to result.
+ * @param C Result $C = SB$.
+ * @param S Sparse matrix $S$.
+ * @param B Matrix $B$.
+ *
+ * @return Gradient with respect to the nonzero elements of @p S, as a sparse
+ * matrix with the same nonzero pattern.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+SparseMatrix<T> mul_grad1(const Array<T,2>& g, const Array<T,2>& C,
+    const SparseMatrix<T>& S, const Array<T,2>& B);
+
+/**
+ * Gradient of operator*().
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param g Gradient with respect to result.
+ * @param C Result $C = SB$.
+ * @param S Sparse matrix $S$.
+ * @param B Matrix $B$.
+ *
+ * @return Gradient with respect to @p B.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> mul_grad2(const Array<T,2>& g, const Array<T,2>& C,
+    const SparseMatrix<T>& S, const Array<T,2>& B);
+
+/**
+ * Sparse-matrix-vector inner product.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param S Sparse matrix $S$.
+ * @param x Vector $x$.
+ *
+ * @return Result $y = S^\top x$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> inner(const SparseMatrix<T>& S, const Array<T,1>& x);
+
+/**
+ * Sparse-matrix-matrix inner product.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param S Sparse matrix $S$.
+ * @param B Matrix $B$.
+ *
+ * @return Result $C = S^\top B$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> inner(const SparseMatrix<T>& S, const Array<T,2>& B);
+
+/**
+ * Cholesky factorization of a sparse symmetric positive definite matrix.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param S Sparse symmetric positive definite matrix $S$. Only its lower
+ * triangle is used.
+ *
+ * @return Factorization $PSP^\top = LL^\top$. If @p S is not positive
+ * definite, the factor is filled with NaN.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+SparseCholesky<T> chol(const SparseMatrix<T>& S);
+
+/**
+ * Matrix-vector solve, via a sparse Cholesky factorization.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param C Factorization $PSP^\top = LL^\top$.
+ * @param y Vector $y$.
+ *
+ * @return Solution of $x$ in $Sx = y$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> cholsolve(const SparseCholesky<T>& C, const Array<T,1>& y);
+
+/**
+ * Matrix-matrix solve, via a sparse Cholesky factorization.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param C Factorization $PSP^\top = LL^\top$.
+ * @param B Matrix $B$.
+ *
+ * @return Solution of $X$ in $SX = B$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,2> cholsolve(const SparseCholesky<T>& C, const Array<T,2>& B);
+
+/**
+ * Transposed triangular solve, via a sparse Cholesky factorization.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param C Factorization $PSP^\top = LL^\top$.
+ * @param y Vector $y$.
+ *
+ * @return Result $x = P^\top L^{-\top}y$. If $y$ is standard Gaussian, then
+ * $x$ is Gaussian with covariance $S^{-1}$, i.e. precision $S$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,1> triinnersolve(const SparseCholesky<T>& C, const Array<T,1>& y);
+
+/**
+ * Logarithm of the determinant of a symmetric positive definite matrix, via
+ * a sparse Cholesky factorization.
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param C Factorization $PSP^\top = LL^\top$.
+ *
+ * @return Result $\log\det S = 2\log\det L$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+Array<T,0> lcholdet(const SparseCholesky<T>& C);
+
+/**
+ * Gradient of lcholdet().
+ *
+ * @ingroup sparse
+ *
+ * @tparam T Floating point type.
+ *
+ * @param g Gradient with respect to result.
+ * @param d Result $d = \log\det S$.
+ * @param C Factorization $PSP^\top = LL^\top$.
+ * @param S Sparse matrix $S$.
+ *
+ * @return Gradient with respect to the nonzero elements of @p S, as a sparse
+ * matrix with the same nonzero pattern. This is $gS^{-1}$ restricted to that
+ * pattern, and requires one solve for each nonempty column of $S$.
+ */
+template<class T, class = std::enable_if_t<is_real_v<T>,int>>
+SparseMatrix<T> lcholdet_grad(const Array<T,0>& g, const Array<T,0>& d,
+    const SparseCholesky<T>& C, const SparseMatrix<T>& S);
+
+}
@@ -0,0 +1,153 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace numbirch {
+/**
+ * Set the maximum number of threads used by a single operation called
+ * outside of any parallel region.
+ *
+ * @ingroup thread
+ *
+ * @param n Number of threads. If zero, the default, uses the maximum number
+ * of OpenMP threads.
+ */
+void set_max_threads(const int n);
+
+/**
+ * Get the maximum number of threads used by a single operation called
+ * outside of any parallel region.
+ *
+ * @ingroup thread
+ */
+int get_max_threads();
+
+/**
+ * Set the maximum number of threads used by a single operation called
+ * inside a parallel region, e.g. one over particles.
+ *
+ * @ingroup thread
+ *
+ * @param n Number of threads. The default is one, in which case operations
+ * inside a parallel region run on the calling thread only. If greater than
+ * one, such operations start a nested team of up to this many threads,
+ * which can make use of cores left idle towards the end of an unbalanced
+ * parallel region, at the cost of oversubscribing them otherwise.
+ */
+void set_max_nested_threads(const int n);
+
+/**
+ * Get the maximum number of threads used by a single operation called
+ * inside a parallel region.
+ *
+ * @ingroup thread
+ */
+int get_max_nested_threads();
+
+/**
+ * Set the minimum size of an operation, in number of elements, for which it
+ * is divided into blocks that may be distributed over threads.
+ *
+ * @ingroup thread
+ *
+ * @param n Number of elements.
+ *
+ * Results of reductions depend on this threshold, through the order in which
+ * elements are combined, but not on the number of threads.
+ */
+void set_parallel_min(const int64_t n);
+
+/**
+ * Get the minimum size of an operation, in number of elements, for which it
+ * is divided into blocks that may be distributed over threads.
+ *
+ * @ingroup thread
+ */
+int64_t get_parallel_min();
+
+/**
+ * Is the calling thread inside a parallel region?
+ *
+ * @ingroup thread
+ */
+bool in_parallel();
+
+/**
+ * Get the number of threads that a single operation called from the
+ * calling thread may use, according to the above settings and whether it
+ * is inside a parallel region.
+ *
+ * @ingroup thread
+ */
+int get_op_threads();
+
+/**
+ * Set whether array buffers are placed on the NUMA node of the thread that
+ * allocates them.
+ *
+ * @ingroup thread
+ *
+ * @param on Enable?
+ *
+ * By default, placement is left to the operating system, which usually
+ * places a page on the node of the thread that first touches it. Memory
+ * recycled by the allocator, however, may already reside on another node.
+ * When enabled, the pages of each new buffer are bound to, and if necessary
+ * migrated to, the node of the allocating thread. This suits programs in
+ * which each array is allocated by the thread that goes on to use it, e.g.
+ * one over particles with a static schedule and threads pinned to cores.
+ * Only the Eigen backend supports placement; elsewhere this has no effect.
+ */
+void set_numa_local(const bool on);
+
+/**
+ * Are array buffers placed on the NUMA node of the thread that allocates
+ * them?
+ *
+ * @ingroup thread
+ */
+bool get_numa_local();
+
+/**
+ * Get the NUMA node of the calling thread.
+ *
+ * @ingroup thread
+ *
+ * @return Node of the CPU on which the calling thread is currently running,
+ * or zero if unknown.
+ */
+int get_numa_node();
+
+/**
+ * Get the NUMA node on which memory resides.
+ *
+ * @ingroup thread
+ *
+ * @param ptr Address.
+ *
+ * @return Node of the page containing @p ptr, or -1 if unknown, e.g. if the
+ * page has not yet been touched.
+ */
+int get_numa_node(const void* ptr);
+
+/**
+ * @internal
+ *
+ * Bind memory to the NUMA node of the calling thread, migrating any pages
+ * that already reside elsewhere.
+ *
+ * @ingroup thread
+ *
+ * @param ptr Address.
+ * @param size Size, in bytes.
+ *
+ * Only whole pages within the range are bound, so that neighboring
+ * allocations are unaffected. Does nothing if unsupported.
+ */
+void numa_place(void* ptr, const size_t size);
+
+}
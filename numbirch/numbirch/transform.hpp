@@ -8,6 +8,8 @@
 #include "numbirch/array/Vector.hpp"
 #include "numbirch/array/Matrix.hpp"
 
+#include <utility>
+
 namespace numbirch {
 /**
  * Logical `not`.
@@ -1300,6 +1302,30 @@ template<class T, class U, class = std::enable_if_t<is_numeric_v<T> &&
 real_t<U> lbeta_grad2(const real_t<T,U>& g, const real_t<T,U>& z, const T& x,
     const U& y);
 
+/**
+ * Gradient of lbeta(), with respect to both arguments, computed together.
+ * 
+ * @ingroup transform_grad
+ * 
+ * @tparam T Numeric type.
+ * @tparam U Numeric type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param z Result.
+ * @param x Argument.
+ * @param y Argument.
+ * 
+ * @return Pair of gradients with respect to @p x and @p y.
+ *
+ * This is equivalent to calling lbeta_grad1() and lbeta_grad2(), but makes
+ * one pass rather than two, and evaluates the digamma function of `x + y`
+ * once rather than twice.
+ */
+template<class T, class U, class = std::enable_if_t<is_numeric_v<T> &&
+    is_numeric_v<U>,int>>
+std::pair<real_t<T>,real_t<U>> lbeta_grad(const real_t<T,U>& g,
+    const real_t<T,U>& z, const T& x, const U& y);
+
 /**
  * Logarithm of the binomial coefficient.
  * 
@@ -1357,6 +1383,30 @@ template<class T, class U, class = std::enable_if_t<is_numeric_v<T> &&
 real_t<U> lchoose_grad2(const real_t<T,U>& g, const real_t<T,U>& z,
     const T& x, const U& y);
 
+/**
+ * Gradient of lchoose(), with respect to both arguments, computed together.
+ * 
+ * @ingroup transform_grad
+ * 
+ * @tparam T Numeric type.
+ * @tparam U Numeric type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param z Result.
+ * @param x Argument.
+ * @param y Argument.
+ * 
+ * @return Pair of gradients with respect to @p x and @p y.
+ *
+ * This is equivalent to calling lchoose_grad1() and lchoose_grad2(), but
+ * makes one pass rather than two, and evaluates the digamma function of
+ * `x - y + 1` once rather than twice.
+ */
+template<class T, class U, class = std::enable_if_t<is_numeric_v<T> &&
+    is_numeric_v<U>,int>>
+std::pair<real_t<T>,real_t<U>> lchoose_grad(const real_t<T,U>& g,
+    const real_t<T,U>& z, const T& x, const U& y);
+
 /**
  * Logarithm of the factorial function.
  * 
@@ -1658,6 +1708,29 @@ template<class T, class U, class = std::enable_if_t<is_numeric_v<T> &&
 real_t<U> pow_grad2(const real_t<T,U>& g, const real_t<T,U>& z, const T& x,
     const U& y);
 
+/**
+ * Gradient of pow(), with respect to both arguments, computed together.
+ * 
+ * @ingroup transform_grad
+ * 
+ * @tparam T Numeric type.
+ * @tparam U Numeric type.
+ * 
+ * @param g Gradient with respect to result.
+ * @param z Result.
+ * @param x Argument.
+ * @param y Argument.
+ * 
+ * @return Pair of gradients with respect to @p x and @p y.
+ *
+ * This is equivalent to calling pow_grad1() and pow_grad2(), but makes one
+ * pass rather than two, and reuses the result rather than recomputing it.
+ */
+template<class T, class U, class = std::enable_if_t<is_numeric_v<T> &&
+    is_numeric_v<U>,int>>
+std::pair<real_t<T>,real_t<U>> pow_grad(const real_t<T,U>& g,
+    const real_t<T,U>& z, const T& x, const U& y);
+
 /**
  * Rectification.
  * 
@@ -175,6 +175,22 @@ struct value_s<Array<T,D>> {
 template<class T>
 using value_t = typename value_s<std::decay_t<T>>::type;
 
+/**
+ * @typedef accumulate_t
+ *
+ * Type in which to accumulate a reduction over elements of type `T`. This is
+ * `double` for `float`, and `T` otherwise.
+ *
+ * @ingroup trait
+ *
+ * Single precision builds are thus mixed precision: arrays and elementwise
+ * kernels use `float` for bandwidth and vector width, while reductions such
+ * as sum() and dot() accumulate in `double`, rounding only the result.
+ */
+template<class T>
+using accumulate_t = std::conditional_t<std::is_same_v<std::decay_t<T>,float>,
+    double,std::decay_t<T>>;
+
 /**
  * @var dimension_v
  *